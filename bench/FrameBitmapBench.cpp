@@ -0,0 +1,109 @@
+// Free-frame tracking: FrameBitmap against the std::set<int> it replaced, over 1M frames.
+// Not part of main.exe; build and run from the repository root with
+//   g++ -std=c++20 -O2 -I src bench/FrameBitmapBench.cpp -o frame_bitmap_bench && ./frame_bitmap_bench
+
+#include "memory/FrameBitmap.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+static const int FRAME_COUNT = 1 << 20;
+static const int FRAMES_PER_PROCESS = 64;
+
+template <typename Work>
+static double timeMillis(Work&& work) {
+    auto started = std::chrono::steady_clock::now();
+    work();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+}
+
+struct Timings {
+    double build = 0;
+    double takeAll = 0;
+    double freeHalf = 0;
+    double retakeHalf = 0;
+};
+
+// Each run fills memory with processes of FRAMES_PER_PROCESS frames, frees a random half of the
+// processes and takes the same number of frames back, as the pager does under churn.
+static Timings runSet(const std::vector<int>& releaseOrder, long long& checksum) {
+    Timings timings;
+    std::vector<std::vector<int>> processes(FRAME_COUNT / FRAMES_PER_PROCESS);
+    std::set<int> freeFrames;
+
+    timings.build = timeMillis([&] {
+        for (int frame = 0; frame < FRAME_COUNT; ++frame) freeFrames.insert(frame);
+    });
+    timings.takeAll = timeMillis([&] {
+        for (auto& frames : processes) {
+            for (int i = 0; i < FRAMES_PER_PROCESS; ++i) {
+                frames.push_back(*freeFrames.begin());
+                freeFrames.erase(freeFrames.begin());
+            }
+        }
+    });
+    timings.freeHalf = timeMillis([&] {
+        for (size_t i = 0; i < releaseOrder.size() / 2; ++i) {
+            for (int frame : processes[releaseOrder[i]]) freeFrames.insert(frame);
+        }
+    });
+    timings.retakeHalf = timeMillis([&] {
+        for (int i = 0; i < FRAME_COUNT / 2; ++i) {
+            checksum += *freeFrames.begin();
+            freeFrames.erase(freeFrames.begin());
+        }
+    });
+    return timings;
+}
+
+static Timings runBitmap(const std::vector<int>& releaseOrder, long long& checksum) {
+    Timings timings;
+    std::vector<std::vector<int>> processes(FRAME_COUNT / FRAMES_PER_PROCESS);
+    std::unique_ptr<FrameBitmap> freeFrames;
+
+    timings.build = timeMillis([&] {
+        freeFrames = std::make_unique<FrameBitmap>(FRAME_COUNT);
+    });
+    timings.takeAll = timeMillis([&] {
+        for (auto& frames : processes) {
+            for (int i = 0; i < FRAMES_PER_PROCESS; ++i) frames.push_back(freeFrames->takeFirst());
+        }
+    });
+    timings.freeHalf = timeMillis([&] {
+        for (size_t i = 0; i < releaseOrder.size() / 2; ++i) freeFrames->releaseAll(processes[releaseOrder[i]]);
+    });
+    timings.retakeHalf = timeMillis([&] {
+        for (int i = 0; i < FRAME_COUNT / 2; ++i) checksum += freeFrames->takeFirst();
+    });
+    return timings;
+}
+
+int main() {
+    std::vector<int> releaseOrder(FRAME_COUNT / FRAMES_PER_PROCESS);
+    for (size_t i = 0; i < releaseOrder.size(); ++i) releaseOrder[i] = static_cast<int>(i);
+    std::shuffle(releaseOrder.begin(), releaseOrder.end(), std::mt19937(1));
+
+    long long setChecksum = 0;
+    long long bitmapChecksum = 0;
+    Timings set = runSet(releaseOrder, setChecksum);
+    Timings bitmap = runBitmap(releaseOrder, bitmapChecksum);
+
+    std::printf("%d frames, %d frames per process (times in ms)\n", FRAME_COUNT, FRAMES_PER_PROCESS);
+    std::printf("                      std::set    bitmap\n");
+    std::printf("  build free list     %8.1f  %8.1f\n", set.build, bitmap.build);
+    std::printf("  take all frames     %8.1f  %8.1f\n", set.takeAll, bitmap.takeAll);
+    std::printf("  free half the procs %8.1f  %8.1f\n", set.freeHalf, bitmap.freeHalf);
+    std::printf("  retake half         %8.1f  %8.1f\n", set.retakeHalf, bitmap.retakeHalf);
+
+    // Both hand out the lowest free frame first, so they must have taken the same frames.
+    if (setChecksum != bitmapChecksum) {
+        std::fprintf(stderr, "Error: std::set and FrameBitmap handed out different frames.\n");
+        return 1;
+    }
+    return 0;
+}
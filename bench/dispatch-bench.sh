@@ -0,0 +1,55 @@
+#!/bin/bash
+# Page-fault rate against ready-queue wait for RR dispatch policies: fifo, then resident-first
+# at each bypass bound. Every run starts the scheduler on bench/dispatch-bench.config, lets it run
+# RUN_SECONDS, and reads vmstat; the table averages RUNS runs per row.
+#
+#   bench/dispatch-bench.sh <path to the built simulator> [bypass bounds...]   (default 4 16 64)
+#
+# Environment: RUNS (default 3), RUN_SECONDS (default 6).
+
+set -u
+
+if [ $# -lt 1 ] || [ ! -x "$1" ]; then
+    echo "Usage: $0 <simulator binary> [bypass bounds...]" >&2
+    exit 1
+fi
+
+binary=$(cd "$(dirname "$1")" && pwd)/$(basename "$1")
+shift
+bounds=${*:-4 16 64}
+runs=${RUNS:-3}
+runSeconds=${RUN_SECONDS:-6}
+repo=$(cd "$(dirname "$0")/.." && pwd)
+
+# Prints "faults activeTicks avgWait maxWait" for one run.
+runOnce() {
+    local policy=$1 bypass=$2 dir
+    dir=$(mktemp -d)
+    cat "$repo/config.txt" > "$dir/config.txt"
+    printf "\n" >> "$dir/config.txt"
+    cat "$repo/bench/dispatch-bench.config" >> "$dir/config.txt"
+    printf "dispatch-policy = %s\ndispatch-max-bypass = %s\n" "$policy" "$bypass" >> "$dir/config.txt"
+
+    (cd "$dir" && { echo initialize; echo scheduler-start; sleep "$runSeconds"; echo vmstat;
+                    echo scheduler-stop; sleep 1; echo exit; } | timeout 120 "$binary" 2>&1) \
+        | sed 's/\x1b\[[0-9;]*[a-zA-Z]//g' \
+        | awk '/Num Page Faults:/ { faults = $NF }
+               /Active CPU Ticks:/ { active = $NF }
+               /Avg Ready Wait:/ { avg = $4 }
+               /Max Ready Wait:/ { max = $4 }
+               END { print faults + 0, active + 0, avg + 0, max + 0 }'
+    rm -rf "$dir"
+}
+
+row() {
+    local policy=$1 bypass=$2 label=$3 i
+    for ((i = 0; i < runs; ++i)); do runOnce "$policy" "$bypass"; done \
+        | awk -v label="$label" '{ faults += $1; active += $2; avg += $3; if ($4 > max) max = $4; n++ }
+               END { printf "%-22s %12.1f %14.2f %14d\n", label, active ? 1000 * faults / active : 0, avg / n, max }'
+}
+
+printf "%-22s %12s %14s %14s\n" "policy / bypass" "faults/1K" "avg wait" "max wait"
+row fifo 0 "fifo"
+for bypass in $bounds; do
+    row resident-first "$bypass" "resident-first / $bypass"
+done
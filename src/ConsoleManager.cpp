@@ -7,6 +7,8 @@
 #include "memory/IMemoryAllocator.h"
 #include "memory/FlatMemoryAllocator.h"
 #include "memory/DemandPagingAllocator.h"
+#include "memory/BuddyAllocator.h"
+#include "memory/SegregatedFitAllocator.h"
 #include "memory/BackingStore.h"
 
 #include <iostream>
@@ -127,27 +129,42 @@ std::string ConsoleManager::getTimestamp() {
 }
 
 bool ConsoleManager::doesProcessExist(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(processesMtx);
     return processes.count(name) > 0;
 }
 
 std::shared_ptr<const Process> ConsoleManager::getProcess(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(processesMtx);
     auto it = processes.find(name);
     return (it != processes.end()) ? it->second : nullptr;
 }
 
 std::shared_ptr<Process> ConsoleManager::getProcessMutable(const std::string& name) {
+    std::lock_guard<std::mutex> lock(processesMtx);
     auto it = processes.find(name);
     return (it != processes.end()) ? it->second : nullptr;
 }
 
 const std::map<std::string, std::shared_ptr<Process>>& ConsoleManager::getAllProcesses() const {
     static std::map<std::string, std::shared_ptr<Process>> all;
+    std::lock_guard<std::mutex> lock(processesMtx);
     all.clear();
     all.insert(processes.begin(), processes.end());
     all.insert(finishedProcesses.begin(), finishedProcesses.end());
     return all;
 }
 
+std::map<std::string, std::shared_ptr<Process>> ConsoleManager::getFinishedProcesses() const {
+    std::lock_guard<std::mutex> lock(processesMtx);
+    return finishedProcesses;
+}
+
+void ConsoleManager::addProcessEntry(const std::string& name, std::shared_ptr<Process> process) {
+    std::lock_guard<std::mutex> lock(processesMtx);
+    processes[name] = process;
+    processConsoleScreens[name] = std::make_unique<ProcessConsole>(process);
+}
+
 bool ConsoleManager::createProcessConsole(const std::string& name) {
     if (doesProcessExist(name)) {
         std::cout << "Screen '" << name << "' already exists. Use 'screen -r " << name << "' to resume." << std::endl;
@@ -179,11 +196,10 @@ bool ConsoleManager::createProcessConsole(const std::string& name) {
         newProcess->setMemory(memoryRequired, 0);
         
         if (scheduler && scheduler->getAlgorithmType() == SchedulerAlgorithmType::rr) {
-            processes[name] = newProcess; 
+            addProcessEntry(name, newProcess);
             scheduler->addProcessToRRPendingQueue(newProcess);
             newProcess->addLogEntry("(" + getTimestamp() + ") Process " + newProcess->getProcessName() +
                                      " (PID:" + newProcess->getPid() + ") created and added to RR pending queue (awaiting memory allocation).");
-            processConsoleScreens[name] = std::make_unique<ProcessConsole>(newProcess); 
             return true;
         } else { 
             void* allocResult = memoryAllocator->allocate(newProcess);
@@ -191,13 +207,12 @@ bool ConsoleManager::createProcessConsole(const std::string& name) {
                 //std::cerr << "[ERROR] Memory allocation failed for process '" << name << "' (FCFS/immediate allocation required). Process not created/queued." << std::endl;
                 return false;
             } else {
-                processes[name] = newProcess;
+                addProcessEntry(name, newProcess);
                 if (scheduler) {
                     scheduler->addProcess(newProcess); 
                 } else {
                     std::cerr << "[WARNING] Scheduler not initialized. Process '" << name << "' created but not queued for execution (FCFS scenario)." << std::endl;
                 }
-                processConsoleScreens[name] = std::make_unique<ProcessConsole>(newProcess);
                 return true;
             }
         }
@@ -231,12 +246,11 @@ bool ConsoleManager::createProcessConsole(const std::string& name, uint32_t memo
         newProcess->setMemory(memorySize, 0);
         
         if (scheduler && scheduler->getAlgorithmType() == SchedulerAlgorithmType::rr) {
-            processes[name] = newProcess; 
+            addProcessEntry(name, newProcess);
             scheduler->addProcessToRRPendingQueue(newProcess);
             newProcess->addLogEntry("(" + getTimestamp() + ") Process " + newProcess->getProcessName() +
                                      " (PID:" + newProcess->getPid() + ") created with " + std::to_string(memorySize) + 
                                      " bytes memory and added to RR pending queue (awaiting memory allocation).");
-            processConsoleScreens[name] = std::make_unique<ProcessConsole>(newProcess); 
             return true;
         } else { 
             void* allocResult = memoryAllocator->allocate(newProcess);
@@ -244,13 +258,12 @@ bool ConsoleManager::createProcessConsole(const std::string& name, uint32_t memo
                 //std::cerr << "[ERROR] Memory allocation failed for process '" << name << "' (FCFS/immediate allocation required). Process not created/queued." << std::endl;
                 return false;
             } else {
-                processes[name] = newProcess;
+                addProcessEntry(name, newProcess);
                 if (scheduler) {
                     scheduler->addProcess(newProcess); 
                 } else {
                     std::cerr << "[WARNING] Scheduler not initialized. Process '" << name << "' created but not queued for execution (FCFS scenario)." << std::endl;
                 }
-                processConsoleScreens[name] = std::make_unique<ProcessConsole>(newProcess);
                 return true;
             }
         }
@@ -282,11 +295,10 @@ bool ConsoleManager::createCustomProcessConsole(const std::string& name, const s
         newProcess->setMemory(memoryRequired, 0);
         
         if (scheduler && scheduler->getAlgorithmType() == SchedulerAlgorithmType::rr) {
-            processes[name] = newProcess; 
+            addProcessEntry(name, newProcess);
             scheduler->addProcessToRRPendingQueue(newProcess);
             newProcess->addLogEntry("(" + getTimestamp() + ") Process " + newProcess->getProcessName() +
                                      " (PID:" + newProcess->getPid() + ") created with custom instructions and added to RR pending queue (awaiting memory allocation).");
-            processConsoleScreens[name] = std::make_unique<ProcessConsole>(newProcess); 
             return true;
         } else { 
             void* allocResult = memoryAllocator->allocate(newProcess);
@@ -294,13 +306,12 @@ bool ConsoleManager::createCustomProcessConsole(const std::string& name, const s
                 //std::cerr << "[ERROR] Memory allocation failed for process '" << name << "' (FCFS/immediate allocation required). Process not created/queued." << std::endl;
                 return false;
             } else {
-                processes[name] = newProcess;
+                addProcessEntry(name, newProcess);
                 if (scheduler) {
                     scheduler->addProcess(newProcess); 
                 } else {
                     std::cerr << "[WARNING] Scheduler not initialized. Process '" << name << "' created but not queued for execution (FCFS scenario)." << std::endl;
                 }
-                processConsoleScreens[name] = std::make_unique<ProcessConsole>(newProcess);
                 return true;
             }
         }
@@ -327,25 +338,23 @@ bool ConsoleManager::createCustomProcessConsole(const std::string& name, const s
         newProcess->setMemory(memorySize, 0);
         
         if (scheduler && scheduler->getAlgorithmType() == SchedulerAlgorithmType::rr) {
-            processes[name] = newProcess; 
+            addProcessEntry(name, newProcess);
             scheduler->addProcessToRRPendingQueue(newProcess);
             newProcess->addLogEntry("(" + getTimestamp() + ") Process " + newProcess->getProcessName() +
                                      " (PID:" + newProcess->getPid() + ") created with custom instructions and memory size " + 
                                      std::to_string(memorySize) + " bytes, added to RR pending queue (awaiting memory allocation).");
-            processConsoleScreens[name] = std::make_unique<ProcessConsole>(newProcess); 
             return true;
         } else { 
             void* allocResult = memoryAllocator->allocate(newProcess);
             if (!allocResult) {
                 return false;
             } else {
-                processes[name] = newProcess;
+                addProcessEntry(name, newProcess);
                 if (scheduler) {
                     scheduler->addProcess(newProcess); 
                 } else {
                     std::cerr << "[WARNING] Scheduler not initialized. Process '" << name << "' created but not queued for execution (FCFS scenario)." << std::endl;
                 }
-                processConsoleScreens[name] = std::make_unique<ProcessConsole>(newProcess);
                 return true;
             }
         }
@@ -357,6 +366,7 @@ void ConsoleManager::switchToProcessConsole(const std::string& name) {
     std::shared_ptr<Process> processData;
     bool isFinished = false;
     
+    std::unique_lock<std::mutex> lock(processesMtx);
     auto itProcess = processes.find(name);
     if (itProcess != processes.end()) {
         processData = itProcess->second;
@@ -369,11 +379,13 @@ void ConsoleManager::switchToProcessConsole(const std::string& name) {
     }
 
     if (!processData) {
+        lock.unlock();
         std::cout << "Screen '" << name << "' not found." << std::endl;
         return;
     }
 
     if (isFinished) {
+        lock.unlock();
         auto now = std::chrono::system_clock::now();
         std::time_t now_c = std::chrono::system_clock::to_time_t(now);
         std::tm localTime = *std::localtime(&now_c);
@@ -392,19 +404,23 @@ void ConsoleManager::switchToProcessConsole(const std::string& name) {
         return;
     }
 
+    ProcessConsole* pc;
     auto itScreen = processConsoleScreens.find(name);
     if (itScreen != processConsoleScreens.end()) {
-        ProcessConsole* pc = itScreen->second.get();
+        pc = itScreen->second.get();
         pc->updateProcessData(processData);
-        setActiveConsole(pc);
+        lock.unlock();
     } else {
+        pc = (processConsoleScreens[name] = std::make_unique<ProcessConsole>(processData)).get();
+        lock.unlock();
         std::cout << "Creating console for process '" << name << "'." << std::endl;
-        processConsoleScreens[name] = std::make_unique<ProcessConsole>(processData);
-        setActiveConsole(processConsoleScreens[name].get());
     }
+    // Only this thread erases screens, so pc stays valid after the lock is dropped.
+    setActiveConsole(pc);
 }
 
 void ConsoleManager::cleanupTerminatedProcessConsole(const std::string& name) {
+    std::lock_guard<std::mutex> lock(processesMtx);
     auto finishedIt = finishedProcesses.find(name);
     if (finishedIt != finishedProcesses.end()) {
         auto consoleIt = processConsoleScreens.find(name);
@@ -496,6 +512,13 @@ void ConsoleManager::startBatchGen() {
     batchGenRunning.store(true);
     nextBatchTickTarget = scheduler->getSimulatedTime() + batchProcessFrequency;
 
+    if (scheduler->getClockMode() == SchedulerClockMode::virtualTime) {
+        // The scheduling loop generates batch processes itself, on simulated ticks.
+        scheduler->startArrivals(batchProcessFrequency);
+        std::cout << "[INFO] Batch process generation started on simulated time." << std::endl;
+        return;
+    }
+
     batchGenThread = std::make_unique<std::thread>(&ConsoleManager::batchGenLoop, this);
     std::cout << "[INFO] Batch process generation thread started." << std::endl;
 }
@@ -503,6 +526,9 @@ void ConsoleManager::startBatchGen() {
 void ConsoleManager::stopBatchGen() {
     if (batchGenRunning.load()) {
         batchGenRunning.store(false);
+        if (scheduler) {
+            scheduler->stopArrivals();
+        }
 
         if (batchGenThread && batchGenThread->joinable()) {
             batchGenThread->join(); 
@@ -523,7 +549,12 @@ void ConsoleManager::initializeSystem(
     uint32_t maxOverallMem,
     uint32_t memPerFrame,
     uint32_t minMemPerProc,
-    uint32_t maxMemPerProc
+    uint32_t maxMemPerProc,
+    DemandPagingAllocator::PageReplacementPolicy pagePolicy,
+    uint32_t tlbEntries,
+    uint32_t tlbWays,
+    uint32_t compressedPoolBytes,
+    MemoryAllocatorType allocatorType
 ) {
     if (schedulerStarted.load()) {
         return;
@@ -551,34 +582,33 @@ void ConsoleManager::initializeSystem(
     this->minMemoryPerProcess = minMemPerProc;
     this->maxMemoryPerProcess = maxMemPerProc;
 
-    memoryAllocator = std::make_unique<DemandPagingAllocator>(maxOverallMemory, memoryPerFrame, DemandPagingAllocator::PageReplacementPolicy::FIFO);
+    // The old allocator's writer must stop before the store is reset under it.
+    memoryAllocator.reset();
+    BackingStore::reset(memoryPerFrame);
+    if (allocatorType == MemoryAllocatorType::buddy) {
+        memoryAllocator = std::make_unique<BuddyAllocator>(maxOverallMemory, memoryPerFrame);
+    } else if (allocatorType == MemoryAllocatorType::segregated) {
+        memoryAllocator = std::make_unique<SegregatedFitAllocator>(maxOverallMemory, memoryPerFrame);
+    } else {
+        memoryAllocator = std::make_unique<DemandPagingAllocator>(maxOverallMemory, memoryPerFrame, pagePolicy, numCpus, tlbEntries, tlbWays, compressedPoolBytes);
+    }
     batchProcessFrequency = batchFreq;
 
     if (scheduler) {
         scheduler->setProcessTerminationCallback([this](std::shared_ptr<Process> proc) {
             std::string name = proc->getProcessName();
 
+            // Runs under Scheduler::mtx on a core worker, so only processesMtx may be taken here.
+            std::lock_guard<std::mutex> lock(processesMtx);
             auto it = processes.find(name);
             if (it != processes.end()) {
-                if (memoryAllocator) {
-                    memoryAllocator->deallocate(it->second);
-                }
                 finishedProcesses[name] = it->second;
                 processes.erase(it);
             }
-
-            auto consoleIt = processConsoleScreens.find(name);
-            if (consoleIt != processConsoleScreens.end()) {
-                auto finishedProcessIt = finishedProcesses.find(name);
-                if (finishedProcessIt != finishedProcesses.end()) {
-                    consoleIt->second->updateProcessData(finishedProcessIt->second);
-                }
-                
-                if (activeConsole != consoleIt->second.get()) {
-                    processConsoleScreens.erase(consoleIt);
-                }
-            }
+            // The process's screen already points at this same Process and is left alone: the main
+            // thread owns it, and cleanupTerminatedProcessConsole removes it later.
         });
+        scheduler->setArrivalGenerator([this]() { createBatchProcess(); });
 
         nextBatchTickTarget = scheduler->getSimulatedTime() + batchProcessFrequency;
     } else {
@@ -623,6 +653,7 @@ Scheduler* ConsoleManager::getScheduler() const {
 
 std::vector<std::shared_ptr<Process>> ConsoleManager::getProcesses() const {
     std::vector<std::shared_ptr<Process>> list;
+    std::lock_guard<std::mutex> lock(processesMtx);
     for (const auto& [_, proc] : processes) {
         list.push_back(proc);
     }
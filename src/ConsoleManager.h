@@ -7,6 +7,8 @@
 #include "memory/IMemoryAllocator.h"
 #include "memory/FlatMemoryAllocator.h"
 #include "memory/DemandPagingAllocator.h"
+#include "memory/BuddyAllocator.h"
+#include "memory/SegregatedFitAllocator.h"
 #include "memory/BackingStore.h"
 
 #include <string>
@@ -17,6 +19,7 @@
 #include <regex>
 #include <memory>
 #include <atomic> 
+#include <mutex>
 #include <thread>
 
 class AConsole;
@@ -35,12 +38,18 @@ private:
 
     bool exitApp;
 
+    // Guards processes, finishedProcesses and processConsoleScreens: the batch generator creates
+    // processes on the scheduler thread while core workers retire them. Never held across a call
+    // into the scheduler.
+    mutable std::mutex processesMtx;
     std::map<std::string, std::shared_ptr<Process>> processes;
     std::map<std::string, std::shared_ptr<Process>> finishedProcesses;
 
+    void addProcessEntry(const std::string& name, std::shared_ptr<Process> process);
+
 public:
     const std::queue<std::shared_ptr<Process>>& getPendingProcesses() const { return pendingProcesses; }
-    const std::map<std::string, std::shared_ptr<Process>>& getFinishedProcesses() const { return finishedProcesses; }
+    std::map<std::string, std::shared_ptr<Process>> getFinishedProcesses() const;
 
     std::map<std::string, std::unique_ptr<ProcessConsole>> processConsoleScreens;
 
@@ -64,7 +73,7 @@ public:
     uint32_t minMemoryPerProcess;
     uint32_t maxMemoryPerProcess;
 
-    std::unique_ptr<DemandPagingAllocator> memoryAllocator;
+    std::unique_ptr<IMemoryAllocator> memoryAllocator;
 
 public:
     IMemoryAllocator* getMemoryAllocator() const { return memoryAllocator.get(); }
@@ -94,7 +103,12 @@ public:
     uint32_t maxOverallMem,
     uint32_t memPerFrame,
     uint32_t minMemPerProc,
-    uint32_t maxMemPerProc
+    uint32_t maxMemPerProc,
+    DemandPagingAllocator::PageReplacementPolicy pagePolicy = DemandPagingAllocator::PageReplacementPolicy::FIFO,
+    uint32_t tlbEntries = 0,
+    uint32_t tlbWays = 1,
+    uint32_t compressedPoolBytes = 0,
+    MemoryAllocatorType allocatorType = MemoryAllocatorType::paging
     );
 
     bool createProcessConsole(const std::string& name);
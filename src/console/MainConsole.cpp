@@ -4,6 +4,8 @@
 #include "core/Scheduler.h"
 #include "core/Process.h"
 #include "memory/DemandPagingAllocator.h"
+#include "memory/BuddyAllocator.h"
+#include "memory/SegregatedFitAllocator.h"
 #include "memory/BackingStore.h"
 
 #include <regex>
@@ -168,14 +170,145 @@ void MainConsole::handleCommand(const std::string& command) {
                 return;
             }
 
+            SchedulerExecutionMode executionMode = SchedulerExecutionMode::serial;
+            if (config.count("execution-mode")) {
+                const std::string& modeStr = config["execution-mode"];
+                if (modeStr == "serial") executionMode = SchedulerExecutionMode::serial;
+                else if (modeStr == "per-core") executionMode = SchedulerExecutionMode::perCore;
+                else {
+                    std::cerr << "Error: Unknown 'execution-mode' in config.txt: " << modeStr << std::endl;
+                    std::cout << "Initialization failed." << std::endl;
+                    return;
+                }
+            }
+
+            SchedulerClockMode clockMode = SchedulerClockMode::realtime;
+            if (config.count("clock-mode")) {
+                const std::string& clockStr = config["clock-mode"];
+                if (clockStr == "realtime") clockMode = SchedulerClockMode::realtime;
+                else if (clockStr == "virtual") clockMode = SchedulerClockMode::virtualTime;
+                else {
+                    std::cerr << "Error: Unknown 'clock-mode' in config.txt: " << clockStr << std::endl;
+                    std::cout << "Initialization failed." << std::endl;
+                    return;
+                }
+            }
+
+            MemoryAllocatorType allocatorType = MemoryAllocatorType::paging;
+            if (config.count("memory-allocator")) {
+                const std::string& allocatorStr = config["memory-allocator"];
+                if (allocatorStr == "paging") allocatorType = MemoryAllocatorType::paging;
+                else if (allocatorStr == "buddy") allocatorType = MemoryAllocatorType::buddy;
+                else if (allocatorStr == "segregated") allocatorType = MemoryAllocatorType::segregated;
+                else {
+                    std::cerr << "Error: Unknown 'memory-allocator' in config.txt: " << allocatorStr << std::endl;
+                    std::cout << "Initialization failed." << std::endl;
+                    return;
+                }
+            }
+
+            DemandPagingAllocator::PageReplacementPolicy pagePolicy = DemandPagingAllocator::PageReplacementPolicy::FIFO;
+            if (config.count("page-policy")) {
+                const std::string& policyStr = config["page-policy"];
+                if (policyStr == "fifo") pagePolicy = DemandPagingAllocator::PageReplacementPolicy::FIFO;
+                else if (policyStr == "lru") pagePolicy = DemandPagingAllocator::PageReplacementPolicy::LRU;
+                else if (policyStr == "clock") pagePolicy = DemandPagingAllocator::PageReplacementPolicy::CLOCK;
+                else if (policyStr == "lfu") pagePolicy = DemandPagingAllocator::PageReplacementPolicy::LFU;
+                else if (policyStr == "arc") pagePolicy = DemandPagingAllocator::PageReplacementPolicy::ARC;
+                else if (policyStr == "2q") pagePolicy = DemandPagingAllocator::PageReplacementPolicy::TWO_Q;
+                else {
+                    std::cerr << "Error: Unknown 'page-policy' in config.txt: " << policyStr << std::endl;
+                    std::cout << "Initialization failed." << std::endl;
+                    return;
+                }
+            }
+
+            uint32_t tlbEntries = 64, tlbWays = 4;
+            try {
+                if (config.count("tlb-entries")) tlbEntries = std::stoul(config["tlb-entries"]);
+                if (config.count("tlb-ways")) tlbWays = std::stoul(config["tlb-ways"]);
+                if (tlbWays == 0 || tlbEntries % tlbWays != 0) throw std::invalid_argument("ways");
+            } catch (...) {
+                std::cerr << "Error: 'tlb-entries' must be a multiple of a positive 'tlb-ways' (0 entries disables the TLB)." << std::endl;
+                std::cout << "Initialization failed." << std::endl;
+                return;
+            }
+
+            uint32_t compressedPoolBytes = 0;
+            try {
+                if (config.count("compressed-pool-bytes")) compressedPoolBytes = std::stoul(config["compressed-pool-bytes"]);
+            } catch (...) {
+                std::cerr << "Error: Invalid 'compressed-pool-bytes' in config.txt." << std::endl;
+                std::cout << "Initialization failed." << std::endl;
+                return;
+            }
+
+            uint32_t readaheadPages = 0;
+            try {
+                if (config.count("readahead-pages")) readaheadPages = std::stoul(config["readahead-pages"]);
+            } catch (...) {
+                std::cerr << "Error: Invalid 'readahead-pages' in config.txt." << std::endl;
+                std::cout << "Initialization failed." << std::endl;
+                return;
+            }
+
+            SchedulerDispatchPolicy dispatchPolicy = SchedulerDispatchPolicy::fifo;
+            if (config.count("dispatch-policy")) {
+                const std::string& dispatchStr = config["dispatch-policy"];
+                if (dispatchStr == "fifo") dispatchPolicy = SchedulerDispatchPolicy::fifo;
+                else if (dispatchStr == "resident-first") dispatchPolicy = SchedulerDispatchPolicy::residentFirst;
+                else {
+                    std::cerr << "Error: Unknown 'dispatch-policy' in config.txt: " << dispatchStr << std::endl;
+                    std::cout << "Initialization failed." << std::endl;
+                    return;
+                }
+            }
+
+            uint32_t maxDispatchBypass = 8;
+            try {
+                if (config.count("dispatch-max-bypass")) maxDispatchBypass = std::stoul(config["dispatch-max-bypass"]);
+            } catch (...) {
+                std::cerr << "Error: Invalid 'dispatch-max-bypass' in config.txt." << std::endl;
+                std::cout << "Initialization failed." << std::endl;
+                return;
+            }
+
+            uint32_t workingSetWindow = 0;
+            try {
+                if (config.count("working-set-window")) workingSetWindow = std::stoul(config["working-set-window"]);
+            } catch (...) {
+                std::cerr << "Error: Invalid 'working-set-window' in config.txt." << std::endl;
+                std::cout << "Initialization failed." << std::endl;
+                return;
+            }
+
+            bool stridePrefetch = false;
+            if (config.count("stride-prefetch")) {
+                const std::string& strideStr = config["stride-prefetch"];
+                if (strideStr == "on") stridePrefetch = true;
+                else if (strideStr != "off") {
+                    std::cerr << "Error: Unknown 'stride-prefetch' in config.txt: " << strideStr << std::endl;
+                    std::cout << "Initialization failed." << std::endl;
+                    return;
+                }
+            }
+
             ConsoleManager::getInstance()->initializeSystem(
                 numCpus, algoType, batchProcessFreq,
                 minIns, maxIns, delaysPerExec, quantumCycles
                 , maxOverallMem, memPerFrame, minMemPerProc, maxMemPerProc
+                , pagePolicy, tlbEntries, tlbWays, compressedPoolBytes, allocatorType
             );
-
-            std::ofstream ofs("csopesy-backing-store.txt", std::ofstream::out | std::ofstream::trunc);
-            ofs.close();
+            ConsoleManager::getInstance()->getScheduler()->setExecutionMode(executionMode);
+            ConsoleManager::getInstance()->getScheduler()->setClockMode(clockMode);
+            ConsoleManager::getInstance()->getScheduler()->setDispatchPolicy(dispatchPolicy, maxDispatchBypass);
+            if (auto demandPagingAllocator = dynamic_cast<DemandPagingAllocator*>(ConsoleManager::getInstance()->getMemoryAllocator())) {
+                demandPagingAllocator->setReadahead(readaheadPages, stridePrefetch);
+                if (workingSetWindow > 0) {
+                    demandPagingAllocator->setWorkingSetWindow(workingSetWindow);
+                    ConsoleManager::getInstance()->getScheduler()->setWorkingSetFrameBudget(maxOverallMem / memPerFrame);
+                }
+            }
 
             initialized = true;
         } else {
@@ -542,10 +675,29 @@ void MainConsole::handleMainCommands(const std::string& command) {
         
         long long pagesPagedIn = 0;
         long long pagesPagedOut = 0;
-        
-        if (auto demandPagingAllocator = dynamic_cast<DemandPagingAllocator*>(memoryAllocator)) {
+        long long pageFaults = 0;
+        long long pagesPrefetched = 0;
+        long long evictions = 0;
+        long long cleanEvictions = 0;
+        size_t pendingPageOuts = 0;
+        long long pageOutStalls = 0;
+        double evictionLatencyNanos = 0.0;
+        std::string pagePolicyName = "NONE";
+        double pageHitRatio = 0.0;
+        DemandPagingAllocator* demandPagingAllocator = dynamic_cast<DemandPagingAllocator*>(memoryAllocator);
+        
+        if (demandPagingAllocator) {
             pagesPagedIn = demandPagingAllocator->getTotalPagesPagedIn();
             pagesPagedOut = demandPagingAllocator->getTotalPagesPagedOut();
+            pageFaults = demandPagingAllocator->getTotalPageFaults();
+            pagesPrefetched = demandPagingAllocator->getPagesPrefetched();
+            evictions = demandPagingAllocator->getTotalEvictions();
+            cleanEvictions = demandPagingAllocator->getCleanEvictions();
+            pendingPageOuts = demandPagingAllocator->getPendingPageOuts();
+            pageOutStalls = demandPagingAllocator->getPageOutStalls();
+            evictionLatencyNanos = demandPagingAllocator->getAverageEvictionLatencyNanos();
+            pagePolicyName = demandPagingAllocator->getPolicyName();
+            pageHitRatio = demandPagingAllocator->getPolicyHitRatio();
         }
         
         std::cout << "\n--- Memory Information ---" << std::endl;
@@ -568,6 +720,69 @@ void MainConsole::handleMainCommands(const std::string& command) {
         std::cout << "\n--- Paging Information ---" << std::endl;
         std::cout << " Num Paged In: " << pagesPagedIn << std::endl;
         std::cout << " Num Paged Out: " << pagesPagedOut << std::endl;
+        std::cout << " Num Page Faults: " << pageFaults << std::endl;
+        std::cout << " Pages Prefetched: " << pagesPrefetched << std::endl;
+        std::cout << " Num Evictions: " << evictions << std::endl;
+        std::cout << " Clean Evictions: " << cleanEvictions << std::endl;
+        std::cout << " Pending Page-Outs: " << pendingPageOuts << std::endl;
+        std::cout << " Page-Out Stalls: " << pageOutStalls << std::endl;
+        std::cout << " Avg Eviction Latency: " << std::fixed << std::setprecision(2)
+                  << evictionLatencyNanos << " ns" << std::endl;
+        std::cout << " Page Policy: " << pagePolicyName << std::endl;
+        std::cout << " Page Hit Ratio: " << std::fixed << std::setprecision(2)
+                  << (pageHitRatio * 100.0) << "%" << std::endl;
+
+        if (demandPagingAllocator && demandPagingAllocator->getTlbCount() > 0) {
+            std::cout << "\n--- TLB Information ---" << std::endl;
+            std::cout << " Entries per Core: " << demandPagingAllocator->getTlbEntries()
+                      << " (" << demandPagingAllocator->getTlbWays() << "-way)" << std::endl;
+            for (size_t core = 0; core < demandPagingAllocator->getTlbCount(); ++core) {
+                long long hits = demandPagingAllocator->getTlbHits(static_cast<int>(core));
+                long long misses = demandPagingAllocator->getTlbMisses(static_cast<int>(core));
+                double ratio = hits + misses > 0 ? static_cast<double>(hits) / (hits + misses) * 100.0 : 0.0;
+                std::cout << " Core " << core << ": " << hits << " hits, " << misses << " misses ("
+                          << std::fixed << std::setprecision(2) << ratio << "%)" << std::endl;
+            }
+            std::cout << " Shootdowns: " << demandPagingAllocator->getTotalTlbShootdowns() << std::endl;
+        }
+
+        if (demandPagingAllocator && demandPagingAllocator->getCompressedPool().enabled()) {
+            const CompressedPagePool& pool = demandPagingAllocator->getCompressedPool();
+            std::cout << "\n--- Compressed Pool ---" << std::endl;
+            std::cout << " Pool Usage: " << pool.getUsedBytes() << " / " << pool.getBudgetBytes()
+                      << " bytes (" << pool.getPageCount() << " pages)" << std::endl;
+            std::cout << " Compression Ratio: " << std::fixed << std::setprecision(2)
+                      << pool.getCompressionRatio() << ":1" << std::endl;
+            std::cout << " Pool Hit Rate: " << std::fixed << std::setprecision(2)
+                      << (demandPagingAllocator->getCompressedPoolHitRate() * 100.0) << "%" << std::endl;
+            std::cout << " Spilled to Store: " << pool.getSpills() << std::endl;
+        }
+
+        if (scheduler) {
+            WorkingSetController::Stats workingSets = scheduler->getWorkingSetStats();
+            if (workingSets.enabled) {
+                std::cout << "\n--- Working Set Control ---" << std::endl;
+                std::cout << " Thrashing: " << (workingSets.thrashing ? "yes" : "no") << std::endl;
+                std::cout << " Working-Set Demand: " << workingSets.demand << " / " << workingSets.frames << " frames" << std::endl;
+                std::cout << " Admitted Processes: " << workingSets.active
+                          << " (" << workingSets.suspended << " suspended)" << std::endl;
+                std::cout << " Suspensions: " << workingSets.suspensions << std::endl;
+                std::cout << " Resumes: " << workingSets.resumes << std::endl;
+            }
+        }
+
+        if (scheduler && scheduler->getAlgorithmType() == SchedulerAlgorithmType::rr) {
+            Scheduler::DispatchStats dispatch = scheduler->getDispatchStats();
+            std::cout << "\n--- Dispatch ---" << std::endl;
+            std::cout << " Dispatch Policy: "
+                      << (dispatch.policy == SchedulerDispatchPolicy::residentFirst ? "resident-first" : "fifo") << std::endl;
+            std::cout << " Dispatches: " << dispatch.dispatches
+                      << " (" << dispatch.outOfOrder << " out of order, " << dispatch.forced << " forced by bypass limit)" << std::endl;
+            std::cout << " Avg Ready Wait: " << std::fixed << std::setprecision(2)
+                      << (dispatch.dispatches > 0 ? static_cast<double>(dispatch.totalReadyWait) / dispatch.dispatches : 0.0)
+                      << " ticks" << std::endl;
+            std::cout << " Max Ready Wait: " << dispatch.maxReadyWait << " ticks" << std::endl;
+        }
         
     } else if (command == "process-smi") {
         auto consoleManager = ConsoleManager::getInstance();
@@ -702,6 +917,38 @@ void MainConsole::handleMainCommands(const std::string& command) {
         std::cout << " Frame Utilization: " << framesInUse << "/" << totalFrames 
                   << " (" << std::fixed << std::setprecision(2) 
                   << (static_cast<double>(framesInUse) / totalFrames * 100.0) << "%)" << std::endl;
+
+        if (auto buddyAllocator = dynamic_cast<BuddyAllocator*>(memoryAllocator)) {
+            std::cout << "\n--- Buddy Allocator ---" << std::endl;
+            std::cout << " Allocated Blocks: " << buddyAllocator->getAllocatedBlockCount() << std::endl;
+            std::cout << " Free Blocks: " << buddyAllocator->getFreeBlockCount()
+                      << " (" << buddyAllocator->getFreeBytes() << " bytes)" << std::endl;
+            std::cout << " Largest Free Block: " << buddyAllocator->getLargestFreeBlock() << " bytes" << std::endl;
+            std::cout << " External Fragmentation: " << std::fixed << std::setprecision(2)
+                      << (buddyAllocator->getExternalFragmentation() * 100.0) << "%" << std::endl;
+            std::cout << " Internal Fragmentation: " << std::fixed << std::setprecision(2)
+                      << (buddyAllocator->getInternalFragmentation() * 100.0) << "%" << std::endl;
+        }
+
+        if (auto segregatedAllocator = dynamic_cast<SegregatedFitAllocator*>(memoryAllocator)) {
+            long long compactions = segregatedAllocator->getCompactions();
+            std::cout << "\n--- Segregated Fit Allocator ---" << std::endl;
+            std::cout << " Allocations: " << segregatedAllocator->getAllocationCount() << std::endl;
+            std::cout << " Free Extents: " << segregatedAllocator->getFreeExtentCount()
+                      << " (" << segregatedAllocator->getFreeBytes() << " bytes)" << std::endl;
+            std::cout << " Largest Free Extent: " << segregatedAllocator->getLargestFreeExtent() << " bytes" << std::endl;
+            std::cout << " External Fragmentation: " << std::fixed << std::setprecision(2)
+                      << (segregatedAllocator->getExternalFragmentation() * 100.0) << "%" << std::endl;
+            std::cout << " Compactions: " << compactions
+                      << " (" << segregatedAllocator->getBytesCompacted() << " bytes moved)" << std::endl;
+            std::cout << " Admissions by Compaction: " << segregatedAllocator->getAdmissionsByCompaction() << std::endl;
+            std::cout << " Total Compaction Time: " << segregatedAllocator->getTotalCompactionNanos() << " ns";
+            if (compactions > 0) {
+                std::cout << " (avg " << std::fixed << std::setprecision(2)
+                          << static_cast<double>(segregatedAllocator->getTotalCompactionNanos()) / compactions << " ns)";
+            }
+            std::cout << std::endl;
+        }
         
     } else if (command == "backing-store") {
         BackingStore::displayStatus();
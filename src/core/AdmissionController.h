@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <memory>
+#include <utility>
+
+class Process;
+
+// Processes waiting for memory, bucketed by page requirement (FIFO within a bucket).
+// A pass runs only after memory was released or a waiter arrived, and admits from the smallest
+// bucket up until one allocation fails: every allocator here needs at least as much free memory
+// for a larger request as for a smaller one, so nothing behind that failure can fit either.
+class AdmissionController {
+public:
+    AdmissionController() : waiting(0), retryNeeded(false), passes(0), attempts(0) {}
+
+    void enqueue(std::shared_ptr<Process> process, size_t pagesNeeded) {
+        buckets[pagesNeeded].push_back(std::move(process));
+        ++waiting;
+        retryNeeded = true;
+    }
+
+    void onMemoryReleased() {
+        if (waiting > 0) retryNeeded = true;
+    }
+
+    // tryAllocate(const std::shared_ptr<Process>&) -> bool; admit(std::shared_ptr<Process>) is called for each process that got memory.
+    template <typename TryAllocate, typename Admit>
+    size_t admitReady(TryAllocate&& tryAllocate, Admit&& admit) {
+        if (!retryNeeded) return 0;
+        retryNeeded = false;
+        ++passes;
+
+        size_t admitted = 0;
+        for (auto bucket = buckets.begin(); bucket != buckets.end();) {
+            auto& queue = bucket->second;
+            while (!queue.empty()) {
+                ++attempts;
+                if (!tryAllocate(queue.front())) return admitted;
+                admit(std::move(queue.front()));
+                queue.pop_front();
+                --waiting;
+                ++admitted;
+            }
+            bucket = buckets.erase(bucket);
+        }
+        return admitted;
+    }
+
+    size_t size() const { return waiting; }
+    bool empty() const { return waiting == 0; }
+    long long getPasses() const { return passes; }
+    long long getAttempts() const { return attempts; }
+
+private:
+    std::map<size_t, std::deque<std::shared_ptr<Process>>> buckets;
+    size_t waiting;
+    bool retryNeeded;
+    long long passes;
+    long long attempts;
+};
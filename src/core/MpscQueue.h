@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+// Lock-free multi-producer, single-consumer queue.
+// Producers push onto an atomic list head; the consumer takes the whole list in one
+// exchange and replays it oldest-first, so draining is a batch operation by design.
+template <typename T>
+class MpscQueue {
+public:
+    MpscQueue() : head(nullptr) {}
+
+    ~MpscQueue() {
+        drain([](T&&) {});
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Any thread.
+    void push(T value) {
+        Node* node = new Node{std::move(value), head.load(std::memory_order_relaxed)};
+        while (!head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {}
+    }
+
+    // Consumer only. Calls consume(T&&) for every queued value in push order; returns how many.
+    template <typename Consumer>
+    size_t drain(Consumer&& consume) {
+        Node* list = head.exchange(nullptr, std::memory_order_acquire);
+
+        Node* oldestFirst = nullptr;
+        while (list) {
+            Node* next = list->next;
+            list->next = oldestFirst;
+            oldestFirst = list;
+            list = next;
+        }
+
+        size_t count = 0;
+        while (oldestFirst) {
+            Node* next = oldestFirst->next;
+            consume(std::move(oldestFirst->value));
+            delete oldestFirst;
+            oldestFirst = next;
+            ++count;
+        }
+        return count;
+    }
+
+    bool empty() const {
+        return head.load(std::memory_order_relaxed) == nullptr;
+    }
+
+private:
+    struct Node {
+        T value;
+        Node* next;
+    };
+
+    std::atomic<Node*> head;
+};
@@ -1,4 +1,5 @@
 #include "Process.h"
+#include "memory/IMemoryAllocator.h"
 
 #include <iostream>
 #include <cctype>
@@ -25,26 +26,170 @@ Process::Process(const std::string& name, const std::string& p_id, const std::st
 { }
 
 
-int Process::EndFor(int forCommandIndex) const {
-    if (commands[forCommandIndex].type != CommandType::FOR) {
-        throw std::runtime_error("findMatchingEndFor called on non-FOR command.");
-    }
+void Process::compileProgram() {
+    program.clear();
+    literals.clear();
+    program.reserve(commands.size());
 
-    int nestingLevel = 0;
-    for (int i = forCommandIndex + 1; i < commands.size(); ++i) {
-        if (commands[i].type == CommandType::FOR) {
-            nestingLevel++;
-        } else if (commands[i].type == CommandType::END_FOR) {
-            if (nestingLevel == 0) {
-                return i;
+    auto literalFor = [&](std::string text) -> uint32_t {
+        literals.push_back(std::move(text));
+        return static_cast<uint32_t>(literals.size() - 1);
+    };
+    auto parseImmediate = [](const std::string& text) -> uint16_t {
+        try {
+            return static_cast<uint16_t>(std::stoul(text));
+        } catch (...) {
+            return 0;
+        }
+    };
+    auto parseAddress = [](const std::string& text, uint32_t& address) -> bool {
+        try {
+            if (text.substr(0, 2) == "0x" || text.substr(0, 2) == "0X") {
+                address = std::stoul(text, nullptr, 16);
+            } else {
+                address = std::stoul(text);
             }
-            nestingLevel--;
+            return true;
+        } catch (...) {
+            return false;
+        }
+    };
+    // ADD/SUBTRACT operands are either numeric literals or variables (declared as 0 on first use).
+    auto sourceOperand = [&](const std::string& text) -> Operand {
+        Operand operand;
+        if (text.find_first_not_of("0123456789") == std::string::npos) {
+            operand.value = parseImmediate(text);
+        } else {
+            operand.slot = internSlot(text);
         }
+        return operand;
+    };
+    auto unquote = [](const std::string& text) -> std::string {
+        if (text.size() >= 2 && text.front() == '"' && text.back() == '"') {
+            return text.substr(1, text.length() - 2);
+        }
+        return text;
+    };
+
+    std::vector<int32_t> openLoops;
+
+    for (const ParsedCommand& cmd : commands) {
+        Instruction ins;
+        int32_t index = static_cast<int32_t>(program.size());
+
+        switch (cmd.type) {
+            case CommandType::PRINT: {
+                ins.op = OpCode::PRINT;
+                const std::string& printStr = cmd.args.empty() ? std::string() : cmd.args[0];
+                size_t plusPos = printStr.find(" + ");
+                if (plusPos != std::string::npos) {
+                    ins.imm = literalFor(unquote(printStr.substr(0, plusPos)));
+                    ins.lhs.slot = internSlot(printStr.substr(plusPos + 3));
+                } else {
+                    ins.imm = literalFor(unquote(printStr));
+                }
+                break;
+            }
+            case CommandType::DECLARE:
+                ins.op = OpCode::DECLARE;
+                ins.dst.slot = internSlot(cmd.args[0]);
+                ins.lhs.value = parseImmediate(cmd.args[1]);
+                break;
+            case CommandType::ADD:
+            case CommandType::SUBTRACT:
+                ins.op = (cmd.type == CommandType::ADD) ? OpCode::ADD : OpCode::SUBTRACT;
+                ins.dst.slot = internSlot(cmd.args[0]);
+                ins.lhs = sourceOperand(cmd.args[1]);
+                ins.rhs = sourceOperand(cmd.args[2]);
+                break;
+            case CommandType::SLEEP: {
+                ins.op = OpCode::SLEEP;
+                int ticks = 0;
+                try { ticks = std::stoi(cmd.args[0]); } catch (...) { ticks = 0; }
+                ins.imm = static_cast<uint32_t>(std::max(ticks, 0));
+                break;
+            }
+            case CommandType::FOR:
+                ins.op = OpCode::FOR;
+                ins.dst.slot = internSlot(cmd.args[0]);
+                ins.lhs.value = parseImmediate(cmd.args[1]);
+                ins.rhs.value = parseImmediate(cmd.args[2]);
+                ins.imm = parseImmediate(cmd.args[3]);
+                openLoops.push_back(index);
+                break;
+            case CommandType::END_FOR:
+                ins.op = OpCode::END_FOR;
+                if (!openLoops.empty()) {
+                    ins.jump = openLoops.back();
+                    program[openLoops.back()].jump = index;
+                    openLoops.pop_back();
+                }
+                break;
+            case CommandType::WRITE:
+                ins.op = OpCode::WRITE;
+                if (!parseAddress(cmd.args[0], ins.imm)) {
+                    ins.op = OpCode::INVALID;
+                    ins.imm = literalFor("WRITE failed: invalid address '" + cmd.args[0] + "'");
+                    break;
+                }
+                ins.dst.slot = internSlot(cmd.args[1]);
+                break;
+            case CommandType::READ:
+                ins.op = OpCode::READ;
+                if (!parseAddress(cmd.args[1], ins.imm)) {
+                    ins.op = OpCode::INVALID;
+                    ins.imm = literalFor("READ failed: invalid address '" + cmd.args[1] + "'");
+                    break;
+                }
+                ins.dst.slot = internSlot(cmd.args[0]);
+                break;
+            case CommandType::UNKNOWN:
+            default:
+                ins.imm = literalFor("Unknown or unhandled command type.");
+                break;
+        }
+        program.push_back(ins);
+    }
+
+    programCompiled = true;
+}
+
+int32_t Process::internSlot(const std::string& varName) {
+    auto it = slotByName.find(varName);
+    if (it != slotByName.end()) return it->second;
+
+    int32_t slot = static_cast<int32_t>(slotNames.size());
+    slotByName.emplace(varName, slot);
+    slotNames.push_back(varName);
+    slotValues.push_back(0);
+    slotDeclared.push_back(0);
+    return slot;
+}
+
+int32_t Process::findSlot(const std::string& varName) const {
+    auto it = slotByName.find(varName);
+    return it != slotByName.end() ? it->second : NO_SLOT;
+}
+
+bool Process::getOperandValue(const Operand& operand, uint16_t& value) const {
+    if (operand.slot == NO_SLOT) {
+        value = operand.value;
+        return true;
+    }
+    if (!slotDeclared[operand.slot]) {
+        return false;
     }
-    return -1;
+    value = slotValues[operand.slot];
+    return true;
+}
+
+void Process::setSlotValue(int32_t slot, uint16_t value) {
+    slotValues[slot] = value;
+    slotDeclared[slot] = 1;
 }
 
 void Process::addCommand(const std::string& rawCommand) {
+    programCompiled = false;
     std::stringstream ss(rawCommand);
     std::string commandTypeStr;
     
@@ -279,7 +424,10 @@ void Process::generateRandomCommands(int count) {
 
     varCounter = 0; 
     commands.clear();
-    variables.clear();
+    slotValues.clear();
+    slotDeclared.clear();
+    slotNames.clear();
+    slotByName.clear();
     declaredVariableNames.clear();
 
     int initialDeclaresCount = std::min(count / 5, 10);
@@ -384,101 +532,186 @@ void Process::generateRandomCommands(int count) {
         }
     }
     totalInstructionLines = commands.size(); // Final update of totalInstructionLines
+    compileProgram();
 }
 
-const ParsedCommand* Process::getNextCommand() {
-    if (currentCommandIndex >= commands.size() && loopStack.empty()) {
-        return nullptr;
+const Instruction* Process::getNextCommand() {
+    if (!programCompiled) {
+        compileProgram();
     }
 
-    if (!loopStack.empty()) {
-        LoopContext& currentLoop = loopStack.top();
-
-        if (currentCommandIndex == currentLoop.endCommandIndex) {
-            currentLoop.currentLoopValue += currentLoop.stepValue;
-            setVariableValue(currentLoop.loopVarName, currentLoop.currentLoopValue);
-
-            bool conditionMet;
-            if (currentLoop.stepValue > 0) {
-                conditionMet = (currentLoop.currentLoopValue <= currentLoop.endValue);
-            } else if (currentLoop.stepValue < 0) {
-                conditionMet = (currentLoop.currentLoopValue >= currentLoop.endValue);
+    const int programSize = static_cast<int>(program.size());
+    while (currentCommandIndex < programSize) {
+        // Reaching the innermost loop's END_FOR steps the loop variable and either
+        // jumps back to the top of the body or leaves the loop.
+        if (loopDepth > 0 && currentCommandIndex == loopStack[loopDepth - 1].endCommandIndex) {
+            LoopContext& currentLoop = loopStack[loopDepth - 1];
+            uint16_t nextValue = currentLoop.currentLoopValue + currentLoop.stepValue;
+
+            if (nextValue > currentLoop.currentLoopValue && nextValue <= currentLoop.endValue) {
+                currentLoop.currentLoopValue = nextValue;
+                setSlotValue(currentLoop.loopVarSlot, nextValue);
+                currentCommandIndex = currentLoop.startCommandIndex;
             } else {
-                conditionMet = (currentLoop.currentLoopValue == currentLoop.endValue && currentLoop.startValue == currentLoop.endValue);
-                if (currentLoop.startValue != currentLoop.endValue) {
-                    conditionMet = false; 
-                }
+                setSlotValue(currentLoop.loopVarSlot, nextValue);
+                --loopDepth;
+                ++currentCommandIndex;
             }
+            continue;
+        }
 
-            if (conditionMet) {
-                currentCommandIndex = currentLoop.startCommandIndex;
-                return &commands[currentCommandIndex++]; 
+        const Instruction* currentInstruction = &program[currentCommandIndex];
+
+        if (currentInstruction->op == OpCode::FOR) {
+            uint16_t startVal = currentInstruction->lhs.value;
+            uint16_t endVal = currentInstruction->rhs.value;
+            uint16_t stepVal = static_cast<uint16_t>(currentInstruction->imm);
+            int endForIndex = currentInstruction->jump;
+
+            if (endForIndex == -1) {
+                addLogEntry("WARNING: Encountered FOR command without matching END_FOR. Skipping loop.");
+            } else if (loopDepth == MAX_LOOP_DEPTH) {
+                addLogEntry("WARNING: FOR loops nested deeper than " + std::to_string(MAX_LOOP_DEPTH) + " levels. Skipping loop.");
+                currentCommandIndex = endForIndex;
             } else {
-                loopStack.pop();
-                currentCommandIndex++; 
-                return getNextCommand(); 
+                setSlotValue(currentInstruction->dst.slot, startVal);
+
+                if (startVal <= endVal) {
+                    loopStack[loopDepth++] = LoopContext{currentCommandIndex + 1, endForIndex,
+                                                         currentInstruction->dst.slot, startVal, endVal, stepVal};
+                } else {
+                    currentCommandIndex = endForIndex;
+                }
             }
+        } else if (currentInstruction->op == OpCode::END_FOR) {
+            addLogEntry("WARNING: Encountered END_FOR command without active loop context. Advancing.");
         }
+
+        currentCommandIndex++;
+        return currentInstruction;
     }
 
-    if (currentCommandIndex < commands.size()) {
-        const ParsedCommand* currentParsedCommand = &commands[currentCommandIndex];
+    return nullptr;
+}
 
-        switch (currentParsedCommand->type) {
-            case CommandType::FOR: {
-                const std::string& loopVarName = currentParsedCommand->args[0];
-                uint16_t startVal = static_cast<uint16_t>(std::stoul(currentParsedCommand->args[1]));
-                uint16_t endVal = static_cast<uint16_t>(std::stoul(currentParsedCommand->args[2]));
-                uint16_t stepVal = static_cast<uint16_t>(std::stoul(currentParsedCommand->args[3]));
-
-                int endForIndex = EndFor(currentCommandIndex);
-                if (endForIndex == -1) {
-                    throw std::runtime_error("FOR loop at index " + std::to_string(currentCommandIndex) + " has no matching END_FOR.");
-                }
+SliceResult Process::runSlice(int maxInstructions, const SliceContext& context) {
+    int retired = 0;
 
-                declareVariable(loopVarName, startVal);
+    auto terminate = [&]() -> SliceResult {
+        status = ProcessStatus::TERMINATED;
+        finishTime = context.timestamp;
+        addLogEntry(context.logPrefix + "Process " + processName + " (PID:" + pid + ") TERMINATED" +
+                    (isLoopStackEmpty() ? "." : " (after loop)."));
+        return {SliceStopReason::TERMINATED, retired};
+    };
 
-                bool initialConditionMet;
-                if (stepVal > 0) {
-                    initialConditionMet = (startVal <= endVal);
-                } else if (stepVal < 0) {
-                    initialConditionMet = (startVal >= endVal);
-                } else {
-                    initialConditionMet = (startVal == endVal); 
+    while (retired < maxInstructions) {
+        const Instruction* ins = getNextCommand();
+        if (!ins) {
+            return terminate();
+        }
+
+        ++retired;
+        // Names and literals come from the source command; only logging needs them.
+        const std::vector<std::string>& args = getSourceCommand(ins).args;
+
+        switch (ins->op) {
+            case OpCode::PRINT: {
+                std::string printStr = literals[ins->imm];
+                if (ins->lhs.slot != NO_SLOT) {
+                    uint16_t varValue = 0;
+                    if (getOperandValue(ins->lhs, varValue)) {
+                        printStr += std::to_string(varValue);
+                    } else {
+                        printStr += "[undefined_variable:" + slotNames[ins->lhs.slot] + "]";
+                    }
                 }
+                addLogEntry(context.logPrefix + "PRINT " + printStr);
 
-                if (initialConditionMet) {
-                    loopStack.emplace(currentCommandIndex + 1, 
-                                      endForIndex,             
-                                      loopVarName,
-                                      startVal,
-                                      endVal,
-                                      stepVal);
-                } else {
-                    currentCommandIndex = endForIndex; 
+                if (context.touchMemory && !context.touchMemory(*this, context.coreId)) {
+                    return {SliceStopReason::PAGE_FAULT, retired};
                 }
-                break; 
+                break;
+            }
+            case OpCode::DECLARE:
+                setSlotValue(ins->dst.slot, ins->lhs.value);
+                addLogEntry(context.logPrefix + "DECLARE " + args[0] + " = " + std::to_string(ins->lhs.value));
+                break;
+            case OpCode::ADD:
+            case OpCode::SUBTRACT: {
+                // An operand variable that was never declared is declared as 0 on first use.
+                auto getOrDeclare = [&](const Operand& operand) -> uint16_t {
+                    uint16_t value = 0;
+                    if (!getOperandValue(operand, value)) {
+                        setSlotValue(operand.slot, 0);
+                    }
+                    return value;
+                };
+
+                uint16_t val1 = getOrDeclare(ins->lhs);
+                uint16_t val2 = getOrDeclare(ins->rhs);
+                bool isAdd = (ins->op == OpCode::ADD);
+
+                uint16_t result = isAdd ? val1 + val2 : val1 - val2;
+                setSlotValue(ins->dst.slot, result);
+                addLogEntry(context.logPrefix + (isAdd ? "ADD " : "SUBTRACT ") + args[0] + " = " + args[1] + "(" + std::to_string(val1) + ")" +
+                    (isAdd ? " + " : " - ") + args[2] + "(" + std::to_string(val2) + ") => " + args[0] + "(" + std::to_string(result) + ")");
+                break;
             }
-            case CommandType::END_FOR: {
-                addLogEntry("WARNING: Encountered END_FOR command without active loop context. Advancing.");
-                break; 
+            case OpCode::SLEEP:
+                addLogEntry(context.logPrefix + "SLEEP for " + std::to_string(ins->imm) + " ticks.");
+                status = ProcessStatus::PAUSED;
+                sleeping = true;
+                // Instructions retired earlier in this slice have already moved the clock.
+                wakeUpTime = context.simulatedTime + (retired - 1) * context.ticksPerInstruction + ins->imm;
+                return {SliceStopReason::SLEEP, retired};
+            case OpCode::FOR:
+            case OpCode::END_FOR:
+                addLogEntry(context.logPrefix + (ins->op == OpCode::FOR ? "FOR loop entered/re-entered" : "END_FOR reached (loop control)"));
+                break;
+            case OpCode::WRITE: {
+                uint16_t value = 0;
+                if (!getOperandValue(ins->dst, value)) {
+                    addLogEntry(context.logPrefix + "WRITE failed: variable '" + args[1] + "' not found");
+                    break;
+                }
+                MemoryAccessResult access = context.memory ? context.memory->writeWord(*this, context.coreId, ins->imm, value) : MemoryAccessResult::OUT_OF_RANGE;
+                if (access == MemoryAccessResult::OUT_OF_RANGE) {
+                    addLogEntry(context.logPrefix + "WRITE failed: address " + args[0] + " is outside process memory");
+                    break;
+                }
+                addLogEntry(context.logPrefix + "WRITE " + args[0] + " " + args[1] + " (value: " + std::to_string(value) + ")");
+                if (access == MemoryAccessResult::PAGE_FAULT) {
+                    return {SliceStopReason::PAGE_FAULT, retired};
+                }
+                break;
             }
-            case CommandType::DECLARE:
-            case CommandType::ADD:
-            case CommandType::SUBTRACT:
-            case CommandType::SLEEP:
-            case CommandType::PRINT:
-            case CommandType::UNKNOWN:
-            default: {
-                break; 
+            case OpCode::READ: {
+                uint16_t value = 0;
+                MemoryAccessResult access = context.memory ? context.memory->readWord(*this, context.coreId, ins->imm, value) : MemoryAccessResult::OUT_OF_RANGE;
+                if (access == MemoryAccessResult::OUT_OF_RANGE) {
+                    addLogEntry(context.logPrefix + "READ failed: address " + args[1] + " is outside process memory");
+                    break;
+                }
+                setSlotValue(ins->dst.slot, value);
+                addLogEntry(context.logPrefix + "READ " + args[0] + " " + args[1] + " (value: " + std::to_string(value) + ")");
+                if (access == MemoryAccessResult::PAGE_FAULT) {
+                    return {SliceStopReason::PAGE_FAULT, retired};
+                }
+                break;
             }
+            case OpCode::INVALID:
+            default:
+                addLogEntry(context.logPrefix + literals[ins->imm]);
+                break;
         }
-        
-        currentCommandIndex++; 
-        return currentParsedCommand;
     }
 
-    return nullptr; 
+    // Finishing on the last instruction of a quantum terminates now rather than costing another dispatch.
+    if (currentCommandIndex >= static_cast<int>(program.size()) && isLoopStackEmpty()) {
+        return terminate();
+    }
+    return {SliceStopReason::QUANTUM_EXPIRED, retired};
 }
 
 int Process::getCpuCoreExecuting() const {
@@ -490,20 +723,20 @@ void Process::setCpuCoreExecuting(int core) {
 }
 
 void Process::declareVariable(const std::string& varName, uint16_t value) {
-    variables[varName] = value;
+    setSlotValue(internSlot(varName), value);
 }
 
 bool Process::getVariableValue(const std::string& varName, uint16_t& value) const {
-    auto it = variables.find(varName);
-    if (it != variables.end()) {
-        value = it->second;
-        return true;
+    int32_t slot = findSlot(varName);
+    if (slot == NO_SLOT || !slotDeclared[slot]) {
+        return false;
     }
-    return false;
+    value = slotValues[slot];
+    return true;
 }
 
 void Process::setVariableValue(const std::string& varName, uint16_t value) {
-    variables[varName] = value;
+    setSlotValue(internSlot(varName), value);
 }
 
 std::string Process::getCreationTime() const {
@@ -519,7 +752,8 @@ const std::vector<std::string>& Process::getLogEntries() const {
 }
 
 bool Process::doesVariableExist(const std::string& varName) const {
-    return variables.count(varName) > 0;
+    int32_t slot = findSlot(varName);
+    return slot != NO_SLOT && slotDeclared[slot];
 }
 
 bool Process::isSleeping() const {
@@ -550,16 +784,4 @@ uint32_t Process::getMemoryRequired() const {
 
 uint32_t Process::getPagesAllocated() const {
     return pagesAllocated;
-}
-
-void Process::writeMemory(uint32_t address, uint16_t value) {
-    memory[address] = value;
-}
-
-uint16_t Process::readMemory(uint32_t address) {
-    auto it = memory.find(address);
-    if (it != memory.end()) {
-        return it->second;
-    }
-    return 0; 
 }
\ No newline at end of file
@@ -6,12 +6,16 @@
 #include <cstdint>
 #include <sstream>
 #include <algorithm>
-#include <stack>
+#include <array>
 #include <cstdlib>
 #include <ctime>
 #include <random> 
 #include <chrono> 
 #include <set> 
+#include <functional>
+#include <atomic>
+
+#include "memory/WorkingSetEstimator.h"
 
 enum class ProcessStatus {
     NEW,
@@ -43,18 +47,73 @@ struct ParsedCommand {
         : type(t), args(a), originalLineIndex(originalIdx) {}
 };
 
+// Compiled form of a ParsedCommand, one per command. Immediates are parsed once,
+// variables are resolved to per-program slots and FOR/END_FOR carry their matching index.
+enum class OpCode : uint8_t {
+    INVALID,
+    PRINT,
+    DECLARE,
+    ADD,
+    SUBTRACT,
+    SLEEP,
+    FOR,
+    END_FOR,
+    WRITE,
+    READ
+};
+
+constexpr int32_t NO_SLOT = -1;
+
+struct Operand {
+    int32_t slot = NO_SLOT; // variable slot, or NO_SLOT for an immediate
+    uint16_t value = 0;
+};
+
+struct Instruction {
+    OpCode op = OpCode::INVALID;
+    Operand dst; // DECLARE/ADD/SUBTRACT/READ target, FOR loop variable, WRITE source
+    Operand lhs; // ADD/SUBTRACT operands, DECLARE value, FOR start/end, PRINT variable
+    Operand rhs;
+    uint32_t imm = 0;  // SLEEP ticks, WRITE/READ address, FOR step, PRINT/INVALID literal index
+    int32_t jump = -1; // FOR: matching END_FOR, END_FOR: matching FOR
+};
+
+// One active FOR loop. Frames live in a fixed array on the process, no allocation per loop entry.
 struct LoopContext {
     int startCommandIndex;
     int endCommandIndex;
-    std::string loopVarName;
-    uint16_t startValue;
+    int32_t loopVarSlot;
     uint16_t currentLoopValue;
     uint16_t endValue;
     uint16_t stepValue;
+};
+
+constexpr int MAX_LOOP_DEPTH = 16;
+
+class Process;
+class IMemoryAllocator;
+
+enum class SliceStopReason {
+    QUANTUM_EXPIRED,
+    SLEEP,
+    TERMINATED,
+    PAGE_FAULT
+};
+
+struct SliceResult {
+    SliceStopReason reason;
+    int retired; // instructions executed, including the one that stopped the slice
+};
 
-    LoopContext(int startIdx, int endIdx, const std::string& varName, uint16_t currentVal, uint16_t endVal, uint16_t stepVal)
-        : startCommandIndex(startIdx), endCommandIndex(endIdx), loopVarName(varName),
-          currentLoopValue(currentVal), endValue(endVal), stepValue(stepVal) {}
+// What runSlice needs from the scheduler, captured once per slice.
+struct SliceContext {
+    std::string logPrefix;          // "(timestamp) Core:N "
+    std::string timestamp;          // finish time if the process terminates
+    long long simulatedTime;        // simulated time when the slice starts
+    long long ticksPerInstruction;
+    int coreId;
+    std::function<bool(Process&, int)> touchMemory; // PRINT's page access from coreId; false on a page fault
+    IMemoryAllocator* memory;       // where READ/WRITE addresses are translated; may be null
 };
 
 class Process {
@@ -62,27 +121,38 @@ private:
     std::string pid;
     std::string processName;
     std::vector<ParsedCommand> commands;
+    std::vector<Instruction> program;
+    std::vector<std::string> literals;
+    bool programCompiled = false;
     int currentCommandIndex;
     int totalInstructionLines;
     std::string creationTime;
-    ProcessStatus status;
-    int cpuCoreExecuting;
+    // Written by the scheduler and core workers, read by the console without their locks.
+    std::atomic<ProcessStatus> status;
+    std::atomic<int> cpuCoreExecuting;
     std::string finishTime;
     uint32_t memoryRequired = 0;
     uint32_t pagesAllocated = 0;
+    int memoryHandle = -1;
+    WorkingSetEstimator workingSet;
     std::vector<std::string> splitInstructions(const std::string& block);
     std::string trim(const std::string& str);
 
-    std::map<std::string, uint16_t> variables;
-    std::map<uint32_t, uint16_t> memory; 
+    // Variables live in a flat array indexed by slot; the name table is only for lookups by name.
+    std::vector<uint16_t> slotValues;
+    std::vector<uint8_t> slotDeclared;
+    std::vector<std::string> slotNames;
+    std::map<std::string, int32_t> slotByName;
     std::vector<std::string> executionLog;
 
-    std::stack<LoopContext> loopStack;
+    std::array<LoopContext, MAX_LOOP_DEPTH> loopStack;
+    int loopDepth = 0;
 
     bool sleeping;
     long long wakeUpTime;
 
-    int EndFor(int forCommandIndex) const;
+    int32_t internSlot(const std::string& varName);
+    int32_t findSlot(const std::string& varName) const;
 
 public:
     Process(const std::string& name = "", const std::string& p_id = "", const std::string& c_time = "");
@@ -90,6 +160,7 @@ public:
     void addCommand(const std::string& rawCommand);
     void generateDummyPrintCommands(int count, const std::string& baseMessage);
     void generateRandomCommands(int count); 
+    void compileProgram();
 
     const std::string& getPid() const { return pid; }
     const std::string& getProcessName() const { return processName; }
@@ -100,7 +171,11 @@ public:
     ProcessStatus getStatus() const { return status; }
     int getCpuCoreExecuting() const; 
     const std::string& getFinishTime() const { return finishTime; }
-    const ParsedCommand* getNextCommand();
+    const Instruction* getNextCommand();
+    SliceResult runSlice(int maxInstructions, const SliceContext& context);
+    const ParsedCommand& getSourceCommand(const Instruction* instruction) const { return commands[instruction - program.data()]; }
+    const std::string& getLiteral(uint32_t index) const { return literals[index]; }
+    const std::string& getSlotName(int32_t slot) const { return slotNames[slot]; }
 
     void setPid(const std::string& p_id) { pid = p_id; }
     void setProcessName(const std::string& name) { processName = name; }
@@ -115,22 +190,28 @@ public:
     bool getVariableValue(const std::string& varName, uint16_t& value) const;
     void setVariableValue(const std::string& varName, uint16_t value);
 
-    // Memory operations
-    void writeMemory(uint32_t address, uint16_t value);
-    uint16_t readMemory(uint32_t address);
-
     void addLogEntry(const std::string& log);
     const std::vector<std::string>& getLogEntries() const;
 
     bool doesVariableExist(const std::string& varName) const;
 
+    // Slot access for compiled instructions; an operand without a slot reads as its immediate.
+    bool getOperandValue(const Operand& operand, uint16_t& value) const;
+    void setSlotValue(int32_t slot, uint16_t value);
+
     bool isSleeping() const;
     void setSleeping(bool value);
     void setWakeUpTime(long long time);
     long long getWakeUpTime() const;
-    bool isLoopStackEmpty() const { return loopStack.empty(); } 
+    bool isLoopStackEmpty() const { return loopDepth == 0; } 
 
     void setMemory(uint32_t mem, uint32_t pages);
     uint32_t getMemoryRequired() const;
     uint32_t getPagesAllocated() const;
+
+    // Index of this process in the paging allocator's tables; -1 while it holds no memory.
+    int getMemoryHandle() const { return memoryHandle; }
+    void setMemoryHandle(int handle) { memoryHandle = handle; }
+    WorkingSetEstimator& getWorkingSet() { return workingSet; }
+    const WorkingSetEstimator& getWorkingSet() const { return workingSet; }
 };
\ No newline at end of file
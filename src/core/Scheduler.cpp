@@ -12,36 +12,181 @@
 #include "memory/DemandPagingAllocator.h"
 #include <memory>
 #include <random>
+#include <climits>
 
 constexpr long long REAL_TIME_TICK_DURATION_MS = 50; //Lower for much faster processes
+constexpr int SLICE_FLUSH_INTERVAL = 64; // Instructions a core worker runs before publishing ticks/time
 
 Scheduler::Scheduler(int coreCount)
     : numCores(coreCount),
       coreAvailable(coreCount, true),
       running(false),
       currentAlgorithm(SchedulerAlgorithmType::NONE),
-      processQueues(coreCount),
+      processQueues(),
+      dispatchPolicy(SchedulerDispatchPolicy::fifo),
+      maxDispatchBypass(0),
       nextCoreForNewProcess(0),
+      executionMode(SchedulerExecutionMode::serial),
+      stealableWork(0),
+      fcfsInFlight(0),
+      nextSleepOrder(0),
       simulatedTime(0),
+      clockMode(SchedulerClockMode::realtime),
+      arrivalGenerator(nullptr),
+      arrivalInterval(0),
+      nextArrivalTime(0),
       coreAssignments(coreCount, nullptr),
+      coreIdleSince(coreCount, 0),
       delaysPerExecution(0),
       quantumCycles(0),
       totalCpuTicks(0),
       activeCpuTicks(0),
       idleCpuTicks(0),
       mtx(),
-      cv() {}
+      cv() {
+    for (int i = 0; i < coreCount; ++i) {
+        processQueues.push_back(std::make_unique<WorkStealingDeque<std::shared_ptr<Process>>>());
+    }
+}
 
 Scheduler::~Scheduler() {
     stop();
 }
 
 void Scheduler::addProcess(std::shared_ptr<Process> process) {
-    std::lock_guard<std::mutex> lock(mtx);
-    _addProcessUnlocked(process);
+    submissions.push({process, false});
     cv.notify_all();
 }
 
+void Scheduler::addProcessToRRPendingQueue(std::shared_ptr<Process> process) {
+    submissions.push({process, true});
+    cv.notify_all();
+}
+
+void Scheduler::_drainSubmissionsUnlocked() {
+    submissions.drain([&](ProcessSubmission&& submission) {
+        if (submission.awaitingMemory) {
+            uint32_t frameSize = std::max<uint32_t>(ConsoleManager::getInstance()->memoryPerFrame, 1);
+            size_t pagesNeeded = (submission.process->getMemoryRequired() + frameSize - 1) / frameSize;
+            rrPendingAdmissions.enqueue(std::move(submission.process), pagesNeeded);
+        } else {
+            _addProcessUnlocked(std::move(submission.process));
+        }
+    });
+}
+
+void Scheduler::_admitPendingUnlocked() {
+    auto memoryAllocator = ConsoleManager::getInstance()->getMemoryAllocator();
+    if (!memoryAllocator) return;
+
+    // Suspended processes get their memory back before any new process is let in.
+    bool relieved = workingSetControl.rebalance([&](std::shared_ptr<Process> proc) {
+        proc->addLogEntry("(" + getCurrentTimestamp() + ") Process " + proc->getProcessName() +
+                         " (PID:" + proc->getPid() + ") resumed by load control, added to RR Global Queue.");
+        _enqueueReadyUnlocked(std::move(proc));
+    });
+    if (relieved) rrPendingAdmissions.onMemoryReleased();
+    if (!workingSetControl.admitting()) return;
+
+    rrPendingAdmissions.admitReady(
+        [&](const std::shared_ptr<Process>& proc) { return memoryAllocator->allocate(proc) != nullptr; },
+        [&](std::shared_ptr<Process> proc) {
+            proc->addLogEntry("(" + getCurrentTimestamp() + ") Process " + proc->getProcessName() +
+                             " (PID:" + proc->getPid() + ") memory allocated, added to RR Global Queue.");
+            workingSetControl.onAdmitted(proc);
+            _enqueueReadyUnlocked(std::move(proc));
+        });
+}
+
+void Scheduler::_enqueueReadyUnlocked(std::shared_ptr<Process> process) {
+    readyStates[process.get()] = ReadyState{_getSimulatedTimeUnlocked(), 0};
+    globalQueue.push_back(std::move(process));
+}
+
+bool Scheduler::_popRunnableUnlocked(std::shared_ptr<Process>& out) {
+    while (!globalQueue.empty() && workingSetControl.isSuspended(*globalQueue.front())) {
+        std::shared_ptr<Process> proc = std::move(globalQueue.front());
+        globalQueue.pop_front();
+        readyStates.erase(proc.get());
+        proc->addLogEntry("(" + getCurrentTimestamp() + ") Process " + proc->getProcessName() +
+                         " (PID:" + proc->getPid() + ") suspended by load control.");
+        workingSetControl.park(std::move(proc));
+    }
+    if (globalQueue.empty()) return false;
+
+    size_t chosen = _chooseDispatchUnlocked();
+    for (size_t i = 0; i < chosen; ++i) {
+        ++readyStates[globalQueue[i].get()].bypassed;
+    }
+    out = std::move(globalQueue[chosen]);
+    globalQueue.erase(globalQueue.begin() + chosen);
+
+    auto state = readyStates.find(out.get());
+    if (state != readyStates.end()) {
+        long long wait = _getSimulatedTimeUnlocked() - state->second.readySince;
+        dispatchStats.totalReadyWait += wait;
+        dispatchStats.maxReadyWait = std::max(dispatchStats.maxReadyWait, wait);
+        readyStates.erase(state);
+    }
+    ++dispatchStats.dispatches;
+    if (chosen > 0) ++dispatchStats.outOfOrder;
+    return true;
+}
+
+size_t Scheduler::_chooseDispatchUnlocked() {
+    if (dispatchPolicy != SchedulerDispatchPolicy::residentFirst) return 0;
+    auto* demandAllocator = dynamic_cast<DemandPagingAllocator*>(ConsoleManager::getInstance()->getMemoryAllocator());
+    if (!demandAllocator) return 0;
+
+    // Only the first maxBypass + 1 are candidates, so a process moves up at least every time it is passed over.
+    size_t window = std::min<size_t>(globalQueue.size(), static_cast<size_t>(maxDispatchBypass) + 1);
+    size_t best = 0;
+    double bestResident = -1.0;
+    for (size_t i = 0; i < window; ++i) {
+        const Process& proc = *globalQueue[i];
+        if (workingSetControl.isSuspended(proc)) continue;
+        uint32_t pages = proc.getPagesAllocated();
+        double resident = pages > 0 ? static_cast<double>(demandAllocator->getResidentPages(proc.getMemoryHandle())) / pages : 0.0;
+        if (resident > bestResident) {
+            best = i;
+            bestResident = resident;
+        }
+    }
+
+    for (size_t i = 0; i < best; ++i) {
+        auto state = readyStates.find(globalQueue[i].get());
+        if (state != readyStates.end() && state->second.bypassed >= maxDispatchBypass
+                && !workingSetControl.isSuspended(*globalQueue[i])) {
+            ++dispatchStats.forced;
+            return i;
+        }
+    }
+    return best;
+}
+
+void Scheduler::setDispatchPolicy(SchedulerDispatchPolicy policy, uint32_t maxBypass) {
+    std::lock_guard<std::mutex> lock(mtx);
+    dispatchPolicy = policy;
+    maxDispatchBypass = maxBypass;
+}
+
+Scheduler::DispatchStats Scheduler::getDispatchStats() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    DispatchStats stats = dispatchStats;
+    stats.policy = dispatchPolicy;
+    return stats;
+}
+
+void Scheduler::setWorkingSetFrameBudget(size_t frames) {
+    std::lock_guard<std::mutex> lock(mtx);
+    workingSetControl.setFrameBudget(frames);
+}
+
+WorkingSetController::Stats Scheduler::getWorkingSetStats() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return workingSetControl.getStats();
+}
+
 void Scheduler::_addProcessUnlocked(std::shared_ptr<Process> process) {
     if (numCores > 0) {
         if (process->getStatus() == ProcessStatus::NEW) {
@@ -49,11 +194,21 @@ void Scheduler::_addProcessUnlocked(std::shared_ptr<Process> process) {
         }
 
         if (_getAlgorithmTypeUnlocked() == SchedulerAlgorithmType::rr) {
-            globalQueue.push(process);
+            _enqueueReadyUnlocked(process);
             process->addLogEntry("(" + getCurrentTimestamp() + ") Process " + process->getProcessName() +
                                  " (PID:" + process->getPid() + ") added to RR Global Queue.");
         } else {
-            processQueues[nextCoreForNewProcess].push(process);
+            if (executionMode == SchedulerExecutionMode::perCore && !coreWorkers.empty()) {
+                CoreWorker& worker = *coreWorkers[nextCoreForNewProcess];
+                worker.inbox.push(process);
+                {
+                    // Pairs with the predicate check in runFCFSCoreWorker so the wakeup cannot be lost.
+                    std::lock_guard<std::mutex> workerLock(worker.mtx);
+                }
+                worker.cv.notify_one();
+            } else {
+                processQueues[nextCoreForNewProcess]->push(process);
+            }
             process->addLogEntry("(" + getCurrentTimestamp() + ") Process " + process->getProcessName() +
                                  " (PID:" + process->getPid() + ") added to FCFS Queue " + std::to_string(nextCoreForNewProcess) + ".");
             nextCoreForNewProcess = (nextCoreForNewProcess + 1) % numCores;
@@ -70,6 +225,9 @@ void Scheduler::markCoreAvailable(int core) {
 
 void Scheduler::_markCoreAvailableUnlocked(int core) {
     if (core >= 0 && core < coreAvailable.size()) {
+        if (!coreAvailable[core]) {
+            coreIdleSince[core] = _getSimulatedTimeUnlocked();
+        }
         coreAvailable[core] = true;
         coreAssignments[core] = nullptr;
     }
@@ -83,6 +241,15 @@ void Scheduler::start() {
     }
     if (!running.load(std::memory_order_relaxed)) {
         running.store(true, std::memory_order_release);
+        if (executionMode == SchedulerExecutionMode::perCore) {
+            coreWorkers.clear();
+            for (int i = 0; i < numCores; ++i) {
+                coreWorkers.push_back(std::make_unique<CoreWorker>());
+            }
+            for (int i = 0; i < numCores; ++i) {
+                coreWorkers[i]->thread = std::thread(&Scheduler::runCoreWorker, this, i);
+            }
+        }
         schedulerThread = std::make_unique<std::thread>(&Scheduler::runSchedulingLoop, this);
     } else {
         std::cout << "[INFO] Scheduler already running. Ignoring start request." << std::endl;
@@ -99,6 +266,11 @@ void Scheduler::stop() {
         cv.notify_all();
     }
 
+    for (auto& worker : coreWorkers) {
+        std::lock_guard<std::mutex> workerLock(worker->mtx);
+        worker->cv.notify_all();
+    }
+
     if (schedulerThread && schedulerThread->joinable()) {
         if (schedulerThread->get_id() != std::this_thread::get_id()) {
             schedulerThread->join();
@@ -107,27 +279,33 @@ void Scheduler::stop() {
         }
         schedulerThread.reset();
     }
+    for (auto& worker : coreWorkers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+    coreWorkers.clear();
     resetCoreStates();
 }
 
 void Scheduler::resetCoreStates() {
     std::lock_guard<std::mutex> lock(mtx);
+    _drainSubmissionsUnlocked();
     for (size_t i = 0; i < coreAvailable.size(); ++i) {
         coreAvailable[i] = true;
     }
     std::fill(coreAssignments.begin(), coreAssignments.end(), nullptr);
+    std::fill(coreIdleSince.begin(), coreIdleSince.end(), 0);
 
-    sleepingProcesses.clear();
+    sleepingProcesses = {};
 
     for (auto& queue : processQueues) { 
-        while (!queue.empty()) {
-            queue.pop();
-        }
+        queue->clear();
     }
-    while (!globalQueue.empty()) { 
-        globalQueue.pop();
-    }
-    simulatedTime = 0;
+    globalQueue.clear();
+    readyStates.clear();
+    workingSetControl.clear();
+    simulatedTime.store(0);
 }
 
 void Scheduler::setAlgorithmType(SchedulerAlgorithmType type) {
@@ -140,12 +318,59 @@ void Scheduler::_setAlgorithmTypeUnlocked(SchedulerAlgorithmType type) {
 }
 
 SchedulerAlgorithmType Scheduler::getAlgorithmType() const {
-    std::lock_guard<std::mutex> lock(mtx);
     return _getAlgorithmTypeUnlocked();
 }
 
 SchedulerAlgorithmType Scheduler::_getAlgorithmTypeUnlocked() const {
-    return currentAlgorithm;
+    return currentAlgorithm.load(std::memory_order_relaxed);
+}
+
+void Scheduler::setExecutionMode(SchedulerExecutionMode mode) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (running.load(std::memory_order_relaxed)) {
+        std::cerr << "[ERROR] Cannot change execution mode while the scheduler is running." << std::endl;
+        return;
+    }
+    executionMode = mode;
+}
+
+SchedulerExecutionMode Scheduler::getExecutionMode() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return executionMode;
+}
+
+void Scheduler::setClockMode(SchedulerClockMode mode) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (running.load(std::memory_order_relaxed)) {
+        std::cerr << "[ERROR] Cannot change clock mode while the scheduler is running." << std::endl;
+        return;
+    }
+    clockMode = mode;
+}
+
+SchedulerClockMode Scheduler::getClockMode() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return clockMode;
+}
+
+void Scheduler::setArrivalGenerator(ArrivalGenerator generator) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (running.load(std::memory_order_relaxed)) {
+        std::cerr << "[ERROR] Cannot change the batch arrival generator while the scheduler is running." << std::endl;
+        return;
+    }
+    arrivalGenerator = std::move(generator);
+}
+
+void Scheduler::startArrivals(long long interval) {
+    if (interval <= 0 || !arrivalGenerator) return;
+    nextArrivalTime.store(_getSimulatedTimeUnlocked() + interval, std::memory_order_relaxed);
+    arrivalInterval.store(interval, std::memory_order_release);
+    cv.notify_all();
+}
+
+void Scheduler::stopArrivals() {
+    arrivalInterval.store(0, std::memory_order_release);
 }
 
 int Scheduler::getTotalCores() const {
@@ -199,21 +424,29 @@ std::string Scheduler::getCurrentTimestamp() {
     auto now = std::chrono::system_clock::now();
     std::time_t now_c = std::chrono::system_clock::to_time_t(now);
 
+    // Log lines are stamped to the second; only reformat when the second changes.
+    static thread_local std::time_t cachedSecond = 0;
+    static thread_local std::string cachedTimestamp;
+    if (now_c == cachedSecond) {
+        return cachedTimestamp;
+    }
+
     std::tm localTime;
     localtime_s(&localTime, &now_c);
 
     char buffer[64];
     std::strftime(buffer, sizeof(buffer), "%m/%d/%Y %I:%M:%S%p", &localTime);
-    return std::string(buffer);
+    cachedSecond = now_c;
+    cachedTimestamp = buffer;
+    return cachedTimestamp;
 }
 
 long long Scheduler::getSimulatedTime() const {
-    std::lock_guard<std::mutex> lock(mtx);
     return _getSimulatedTimeUnlocked();
 }
 
 long long Scheduler::_getSimulatedTimeUnlocked() const {
-    return simulatedTime;
+    return simulatedTime.load(std::memory_order_relaxed);
 }
 
 void Scheduler::advanceSimulatedTime(long long deltaTime) {
@@ -223,7 +456,7 @@ void Scheduler::advanceSimulatedTime(long long deltaTime) {
 
 void Scheduler::_advanceSimulatedTimeUnlocked(long long deltaTime) {
     if (deltaTime > 0) {
-        simulatedTime += deltaTime;
+        simulatedTime.fetch_add(deltaTime, std::memory_order_relaxed);
     }
 }
 
@@ -233,286 +466,147 @@ void Scheduler::checkSleepingProcesses() {
 }
 
 void Scheduler::_checkSleepingProcessesUnlocked() {
-    std::vector<std::shared_ptr<Process>> wokenProcesses;
-    std::vector<SleepingProcess> stillSleeping;
-
-    for (const auto& sleepCtx : sleepingProcesses) {
-        if (_getSimulatedTimeUnlocked() >= sleepCtx.wakeUpTime) {
-            sleepCtx.process->addLogEntry(
-                "(" + getCurrentTimestamp() + ") Core:" + std::to_string(sleepCtx.assignedCoreId) +
-                " Process " + sleepCtx.process->getProcessName() + 
-                " (PID:" + sleepCtx.process->getPid() + 
-                ") woken up at simulated time " + std::to_string(_getSimulatedTimeUnlocked()) + ".");
-
-            sleepCtx.process->setStatus(ProcessStatus::READY);
-            wokenProcesses.push_back(sleepCtx.process);
-        } else {
-            stillSleeping.push_back(sleepCtx);
-        }
+    if (!_sleepQuickScan()) return;
+
+    long long now = _getSimulatedTimeUnlocked();
+    std::string timestamp = getCurrentTimestamp();
+
+    while (!sleepingProcesses.empty() && sleepingProcesses.top().wakeUpTime <= now) {
+        SleepingProcess sleepCtx = sleepingProcesses.top();
+        sleepingProcesses.pop();
+
+        sleepCtx.process->addLogEntry(
+            "(" + timestamp + ") Core:" + std::to_string(sleepCtx.assignedCoreId) +
+            " Process " + sleepCtx.process->getProcessName() + 
+            " (PID:" + sleepCtx.process->getPid() + 
+            ") woken up at simulated time " + std::to_string(now) + ".");
+
+        sleepCtx.process->setStatus(ProcessStatus::READY);
+        sleepCtx.process->setSleeping(false);
+        _addProcessUnlocked(sleepCtx.process);
     }
 
-    sleepingProcesses = std::move(stillSleeping);
+    cv.notify_all();
+}
+
+bool Scheduler::_sleepQuickScan() const {
+    return !sleepingProcesses.empty() && sleepingProcesses.top().wakeUpTime <= _getSimulatedTimeUnlocked();
+}
 
-    for (const auto& proc : wokenProcesses) {
-        _addProcessUnlocked(proc);
+void Scheduler::runDueArrivals() {
+    // Runs without mtx: the generator creates processes, which only push onto the submission queue.
+    while (running.load(std::memory_order_relaxed)) {
+        long long interval = arrivalInterval.load(std::memory_order_acquire);
+        if (interval <= 0 || _getSimulatedTimeUnlocked() < nextArrivalTime.load(std::memory_order_relaxed)) break;
+        arrivalGenerator();
+        nextArrivalTime.fetch_add(interval, std::memory_order_relaxed);
     }
+}
 
-    if (!wokenProcesses.empty()) {
-        cv.notify_all();
+bool Scheduler::_isIdleUnlocked() const {
+    // Checked first: a worker raises it before it pops or drains its inbox and lowers it only
+    // after the process is dispatched or queued again, or the pop came up empty.
+    if (fcfsInFlight.load() > 0) {
+        return false;
     }
+    if (_getCoresUsedUnlocked() > 0 || !_areAllQueuesEmptyUnlocked()) {
+        return false;
+    }
+    for (const auto& worker : coreWorkers) {
+        if (!worker->inbox.empty()) return false;
+    }
+    return true;
 }
 
-bool Scheduler::_sleepQuickScan() const {
-    for (const auto& sleepCtx : sleepingProcesses) {
-        if (simulatedTime >= sleepCtx.wakeUpTime) {
-            return true;
+bool Scheduler::_advanceToNextEventUnlocked() {
+    long long nextEvent = LLONG_MAX;
+    if (!sleepingProcesses.empty()) {
+        nextEvent = sleepingProcesses.top().wakeUpTime;
+    }
+    if (arrivalInterval.load(std::memory_order_acquire) > 0) {
+        nextEvent = std::min(nextEvent, nextArrivalTime.load(std::memory_order_relaxed));
+    }
+    if (nextEvent == LLONG_MAX) {
+        return false;
+    }
+
+    long long skipped = nextEvent - _getSimulatedTimeUnlocked();
+    if (skipped > 0) {
+        // Every core sat idle through the skipped ticks.
+        idleCpuTicks.fetch_add(skipped * numCores);
+        totalCpuTicks.fetch_add(skipped * numCores);
+        _advanceSimulatedTimeUnlocked(skipped);
+        for (long long& idleSince : coreIdleSince) {
+            idleSince += skipped;
         }
     }
-    return false;
+    _checkSleepingProcessesUnlocked();
+    return true;
 }
 
-bool Scheduler::executeSingleCommand(std::shared_ptr<Process> proc, int coreId) {
-    if (!running.load(std::memory_order_relaxed)) return false;
+// PRINT touches a random page of the process; returns false if that page faulted in.
+static bool touchRandomPage(Process& proc, int coreId) {
+    auto consoleManager = ConsoleManager::getInstance();
+    if (!consoleManager) return true;
 
-    const ParsedCommand* cmd = proc->getNextCommand(); 
-    bool commandExecuted = false;
+    auto* demandAllocator = dynamic_cast<DemandPagingAllocator*>(consoleManager->getMemoryAllocator());
+    uint32_t totalPages = proc.getPagesAllocated();
+    if (!demandAllocator || totalPages == 0) return true;
 
-    if (!cmd) {
-        proc->setStatus(ProcessStatus::TERMINATED);
-        proc->setFinishTime(getCurrentTimestamp());
+    static thread_local std::mt19937 gen(std::random_device{}());
+    std::uniform_int_distribution<int> pageDist(0, totalPages - 1);
+    return demandAllocator->accessMemory(coreId, proc, pageDist(gen));
+}
 
+SliceContext Scheduler::makeSliceContext(int coreId) {
+    std::string timestamp = getCurrentTimestamp();
+    return SliceContext{
+        "(" + timestamp + ") Core:" + std::to_string(coreId) + " ",
+        timestamp,
+        _getSimulatedTimeUnlocked(),
+        1 + static_cast<long long>(delaysPerExecution),
+        coreId,
+        touchRandomPage,
+        ConsoleManager::getInstance()->getMemoryAllocator()
+    };
+}
+
+void Scheduler::accountSlice(const SliceResult& result) {
+    if (result.retired == 0) return;
+    activeCpuTicks.fetch_add(result.retired, std::memory_order_relaxed);
+    totalCpuTicks.fetch_add(result.retired, std::memory_order_relaxed);
+    simulatedTime.fetch_add(result.retired * (1 + static_cast<long long>(delaysPerExecution)), std::memory_order_relaxed);
+}
+
+void Scheduler::_handleStoppedProcessUnlocked(std::shared_ptr<Process> proc, int coreId) {
+    if (proc->getStatus() == ProcessStatus::PAUSED && proc->isSleeping()) {
+        sleepingProcesses.push({proc, proc->getWakeUpTime(), coreId, nextSleepOrder++});
+        proc->setCpuCoreExecuting(-1);
+        _markCoreAvailableUnlocked(coreId);
+    } else if (proc->getStatus() == ProcessStatus::TERMINATED) {
         // Free memory when process terminates
         auto memoryAllocator = ConsoleManager::getInstance()->getMemoryAllocator();
         if (memoryAllocator) {
             memoryAllocator->deallocate(proc);
-        }
-
-        if (!proc->isLoopStackEmpty()) {
-            proc->addLogEntry("(" + getCurrentTimestamp() + ") Core:" + std::to_string(coreId) + 
-                              " Process " + proc->getProcessName() + " (PID:" + proc->getPid() + ") TERMINATED (after loop).");
-        } else {
-            proc->addLogEntry("(" + getCurrentTimestamp() + ") Core:" + std::to_string(coreId) + 
-                              " Process " + proc->getProcessName() + " (PID:" + proc->getPid() + ") TERMINATED.");
+            workingSetControl.onTerminated(*proc);
+            rrPendingAdmissions.onMemoryReleased();
         }
 
         if (onProcessTerminatedCallback) {
             onProcessTerminatedCallback(proc);
         }
-
-        return false;
     }
-
-    std::stringstream log;
-    log << "(" + getCurrentTimestamp() + ") Core:" + std::to_string(coreId) + " ";
-    std::string commandToLog = "";
-
-    switch (cmd->type) {
-        case CommandType::PRINT: {
-            if (!cmd->args.empty()) {
-                std::string printStr = cmd->args[0];
-                
-                size_t plusPos = printStr.find(" + ");
-                if (plusPos != std::string::npos) {
-                    std::string beforePlus = printStr.substr(0, plusPos);
-                    std::string afterPlus = printStr.substr(plusPos + 3);
-                    
-                    if (beforePlus.front() == '"' && beforePlus.back() == '"') {
-                        beforePlus = beforePlus.substr(1, beforePlus.length() - 2);
-                    }
-                    
-                    uint16_t varValue = 0;
-                    if (proc->getVariableValue(afterPlus, varValue)) {
-                        printStr = beforePlus + std::to_string(varValue);
-                    } else {
-                        printStr = beforePlus + "[undefined_variable:" + afterPlus + "]";
-                    }
-                } else {
-                    if (printStr.front() == '"' && printStr.back() == '"') {
-                        printStr = printStr.substr(1, printStr.length() - 2);
-                    }
-                }
-                
-                commandToLog = "PRINT " + printStr;
-                proc->addLogEntry(log.str() + commandToLog);
-                
-                auto consoleManager = ConsoleManager::getInstance();
-                if (consoleManager) {
-                    auto allocator = consoleManager->getMemoryAllocator();
-                    if (allocator) {
-                        auto* demandAllocator = dynamic_cast<DemandPagingAllocator*>(allocator);
-                        if (demandAllocator) {
-                            uint32_t totalPages = proc->getPagesAllocated();
-                            if (totalPages > 0) {
-                                static std::random_device rd;
-                                static std::mt19937 gen(rd());
-                                std::uniform_int_distribution<int> pageDist(0, totalPages - 1);
-                                int pageToAccess = pageDist(gen);
-                                demandAllocator->accessMemory(proc->getPid(), pageToAccess);
-                            }
-                        }
-                    }
-                }
-            }
-            commandExecuted = true;
-            break;
-        }
-        case CommandType::DECLARE: {
-            if (cmd->args.size() == 2) {
-                const std::string& var = cmd->args[0];
-                uint16_t val = static_cast<uint16_t>(std::stoul(cmd->args[1]));
-                proc->declareVariable(var, val);
-                commandToLog = "DECLARE " + var + " = " + std::to_string(val);
-                proc->addLogEntry(log.str() + commandToLog);
-            }
-            commandExecuted = true;
-            break;
-        }
-        case CommandType::ADD: {
-            if (cmd->args.size() == 3) {
-                const std::string& dest = cmd->args[0];
-                const std::string& src1 = cmd->args[1];
-                const std::string& src2 = cmd->args[2];
-
-                uint16_t val1 = 0, val2 = 0;
-
-                auto getOrDeclare = [&](const std::string& name, uint16_t& value_ref) {
-                    if (proc->doesVariableExist(name)) {
-                        proc->getVariableValue(name, value_ref);
-                    } else if (name.find_first_not_of("0123456789") == std::string::npos) {
-                        value_ref = static_cast<uint16_t>(std::stoul(name));
-                    } else {
-                        proc->declareVariable(name, 0);
-                        value_ref = 0;
-                    }
-                };
-
-                getOrDeclare(src1, val1);
-                getOrDeclare(src2, val2);
-
-                uint16_t result = val1 + val2;
-                proc->setVariableValue(dest, result);
-                commandToLog = "ADD " + dest + " = " + src1 + "(" + std::to_string(val1) + ") + " + src2 + "(" + std::to_string(val2) + ") => " + dest + "(" + std::to_string(result) + ")";
-                proc->addLogEntry(log.str() + commandToLog);
-            }
-            commandExecuted = true;
-            break;
-        }
-        case CommandType::SUBTRACT: {
-            if (cmd->args.size() == 3) {
-                const std::string& dest = cmd->args[0];
-                const std::string& src1 = cmd->args[1];
-                const std::string& src2 = cmd->args[2];
-
-                uint16_t val1 = 0, val2 = 0;
-
-                auto getOrDeclare = [&](const std::string& name, uint16_t& value_ref) {
-                    if (proc->doesVariableExist(name)) {
-                        proc->getVariableValue(name, value_ref);
-                    } else if (name.find_first_not_of("0123456789") == std::string::npos) {
-                        value_ref = static_cast<uint16_t>(std::stoul(name));
-                    } else {
-                        proc->declareVariable(name, 0);
-                        value_ref = 0;
-                    }
-                };
-
-                getOrDeclare(src1, val1);
-                getOrDeclare(src2, val2);
-
-                uint16_t result = val1 - val2;
-                proc->setVariableValue(dest, result);
-                commandToLog = "SUBTRACT " + dest + " = " + src1 + "(" + std::to_string(val1) + ") - " + src2 + "(" + std::to_string(val2) + ") => " + dest + "(" + std::to_string(result) + ")";
-                proc->addLogEntry(log.str() + commandToLog);
-            }
-            commandExecuted = true;
-            break;
-        }
-        case CommandType::SLEEP: {
-            if (!cmd->args.empty()) {
-                int ticks = std::stoi(cmd->args[0]);
-                commandToLog = "SLEEP for " + std::to_string(ticks) + " ticks.";
-                proc->addLogEntry(log.str() + commandToLog);
-
-                proc->setStatus(ProcessStatus::PAUSED);
-                sleepingProcesses.push_back({proc, simulatedTime + ticks, coreId});
-
-                proc->setCpuCoreExecuting(-1);
-                _markCoreAvailableUnlocked(coreId);
-                return false; 
-            }
-            commandExecuted = true;
-            break;
-        }
-        case CommandType::FOR:
-        case CommandType::END_FOR:
-            commandToLog = (cmd->type == CommandType::FOR ? "FOR loop entered/re-entered" : "END_FOR reached (loop control)");
-            proc->addLogEntry(log.str() + commandToLog);
-            commandExecuted = true;
-            break;
-        case CommandType::WRITE: {
-            if (cmd->args.size() >= 2) {
-                std::string addressStr = cmd->args[0];
-                std::string varName = cmd->args[1];
-                
-                uint32_t address = 0;
-                if (addressStr.substr(0, 2) == "0x" || addressStr.substr(0, 2) == "0X") {
-                    address = std::stoul(addressStr, nullptr, 16);
-                } else {
-                    address = std::stoul(addressStr);
-                }
-                
-                uint16_t value = 0;
-                if (proc->getVariableValue(varName, value)) {
-                    proc->writeMemory(address, value);
-                    commandToLog = "WRITE " + addressStr + " " + varName + " (value: " + std::to_string(value) + ")";
-                } else {
-                    commandToLog = "WRITE failed: variable '" + varName + "' not found";
-                }
-            } else {
-                commandToLog = "WRITE command with insufficient arguments";
-            }
-            proc->addLogEntry(log.str() + commandToLog);
-            commandExecuted = true;
-            break;
-        }
-        case CommandType::READ: {
-            if (cmd->args.size() >= 2) {
-                std::string varName = cmd->args[0];
-                std::string addressStr = cmd->args[1];
-                
-                uint32_t address = 0;
-                if (addressStr.substr(0, 2) == "0x" || addressStr.substr(0, 2) == "0X") {
-                    address = std::stoul(addressStr, nullptr, 16);
-                } else {
-                    address = std::stoul(addressStr);
-                }
-                
-                uint16_t value = proc->readMemory(address);
-                proc->setVariableValue(varName, value);
-                commandToLog = "READ " + varName + " " + addressStr + " (value: " + std::to_string(value) + ")";
-            } else {
-                commandToLog = "READ command with insufficient arguments";
-            }
-            proc->addLogEntry(log.str() + commandToLog);
-            commandExecuted = true;
-            break;
-        }
-        default:
-            commandToLog = "Unknown or unhandled command type.";
-            proc->addLogEntry(log.str() + commandToLog);
-            commandExecuted = true;
-            break;
-    }
-
-    return commandExecuted; 
 }
 
 bool Scheduler::_areAllQueuesEmptyUnlocked() const {
+    if (!submissions.empty()) {
+        return false;
+    }
     if (_getAlgorithmTypeUnlocked() == SchedulerAlgorithmType::rr) {
         return globalQueue.empty();
     } else {
         for (const auto& q : processQueues) {
-            if (!q.empty()) return false;
+            if (!q->empty()) return false;
         }
         return true;
     }
@@ -523,57 +617,80 @@ void Scheduler::runSchedulingLoop() {
     auto lastRealTimeTick = std::chrono::high_resolution_clock::now();
 
     while (running.load(std::memory_order_acquire)) {
-        std::unique_lock<std::mutex> lock(mtx);
+        if (clockMode == SchedulerClockMode::virtualTime) {
+            runDueArrivals();
+        }
 
-        auto now = std::chrono::high_resolution_clock::now();
-        long long actualDeltaTimeMillis = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastRealTimeTick).count();
+        std::unique_lock<std::mutex> lock(mtx);
 
-        if (actualDeltaTimeMillis >= REAL_TIME_TICK_DURATION_MS) {
-            lastRealTimeTick = now;
-            _advanceSimulatedTimeUnlocked(actualDeltaTimeMillis / REAL_TIME_TICK_DURATION_MS);
+        if (clockMode == SchedulerClockMode::virtualTime) {
             _checkSleepingProcessesUnlocked();
+        } else {
+            auto now = std::chrono::high_resolution_clock::now();
+            long long actualDeltaTimeMillis = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastRealTimeTick).count();
+
+            if (actualDeltaTimeMillis >= REAL_TIME_TICK_DURATION_MS) {
+                lastRealTimeTick = now;
+                _advanceSimulatedTimeUnlocked(actualDeltaTimeMillis / REAL_TIME_TICK_DURATION_MS);
+                _checkSleepingProcessesUnlocked();
+            }
         }
 
-        bool hasReadyProcessesInQueue = (_getAlgorithmTypeUnlocked() == SchedulerAlgorithmType::rr)
-            ? !globalQueue.empty()
-            : std::any_of(processQueues.begin(), processQueues.end(), [](const auto& q) { return !q.empty(); });
+        if (executionMode == SchedulerExecutionMode::serial && clockMode == SchedulerClockMode::realtime) {
+            bool hasReadyProcessesInQueue = (_getAlgorithmTypeUnlocked() == SchedulerAlgorithmType::rr)
+                ? !globalQueue.empty()
+                : std::any_of(processQueues.begin(), processQueues.end(), [](const auto& q) { return !q->empty(); });
 
-        bool anyCoreRunning = (_getCoresUsedUnlocked() > 0);
-        bool hasSleepers = _sleepQuickScan();
+            bool anyCoreRunning = (_getCoresUsedUnlocked() > 0);
+            bool hasSleepers = _sleepQuickScan();
 
-        if (!hasReadyProcessesInQueue && !anyCoreRunning && !hasSleepers) {
-            cv.wait_for(lock, std::chrono::milliseconds(REAL_TIME_TICK_DURATION_MS), [&] {
-                return !running.load(std::memory_order_relaxed)
-                    || !_areAllQueuesEmptyUnlocked()
-                    || _sleepQuickScan();
-            });
-        } else {
-            cv.wait_for(lock, std::chrono::microseconds(100), [&] {
-                return !running.load(std::memory_order_relaxed);
-            });
+            if (!hasReadyProcessesInQueue && !anyCoreRunning && !hasSleepers) {
+                cv.wait_for(lock, std::chrono::milliseconds(REAL_TIME_TICK_DURATION_MS), [&] {
+                    return !running.load(std::memory_order_relaxed)
+                        || !_areAllQueuesEmptyUnlocked()
+                        || _sleepQuickScan();
+                });
+            } else {
+                cv.wait_for(lock, std::chrono::microseconds(100), [&] {
+                    return !running.load(std::memory_order_relaxed);
+                });
+            }
         }
 
         if (!running.load(std::memory_order_relaxed)) break;
 
+        _drainSubmissionsUnlocked();
+
         if (_getAlgorithmTypeUnlocked() == SchedulerAlgorithmType::rr) {
-            size_t pendingCount = rrPendingQueue.size();
-            for (size_t p = 0; p < pendingCount; ++p) {
-                auto proc = rrPendingQueue.front();
-                rrPendingQueue.pop();
-                auto memoryAllocator = ConsoleManager::getInstance()->getMemoryAllocator();
-                bool allocated = false;
-                if (memoryAllocator) {
-                    allocated = (memoryAllocator->allocate(proc) != nullptr);
-                }
-                if (allocated) {
-                    globalQueue.push(proc);
-                    proc->addLogEntry("(" + getCurrentTimestamp() + ") Process " + proc->getProcessName() +
-                                     " (PID:" + proc->getPid() + ") memory allocated, added to RR Global Queue.");
+            _admitPendingUnlocked();
+        }
+
+        if (clockMode == SchedulerClockMode::virtualTime && _isIdleUnlocked()) {
+            // Nothing can run before the next event, so skip straight to it. With no event
+            // scheduled only a new submission (or stop) can make progress.
+            if (!_advanceToNextEventUnlocked()) {
+                cv.wait_for(lock, std::chrono::milliseconds(REAL_TIME_TICK_DURATION_MS), [&] {
+                    return !running.load(std::memory_order_relaxed) || !submissions.empty();
+                });
+            }
+            continue;
+        }
+
+        if (executionMode == SchedulerExecutionMode::perCore) {
+            // Cores run their slices on their own threads; wake up again when one finishes,
+            // a process is submitted, or the next tick is due. Virtual time moves with the
+            // workers, so poll sleepers far more often than the wall-clock tick.
+            _dispatchToCoreWorkersUnlocked();
+            if (submissions.empty()) {
+                if (clockMode == SchedulerClockMode::virtualTime) {
+                    cv.wait_for(lock, std::chrono::microseconds(100));
                 } else {
-                    rrPendingQueue.push(proc);
+                    cv.wait_for(lock, std::chrono::milliseconds(REAL_TIME_TICK_DURATION_MS));
                 }
             }
+            continue;
         }
+
         switch (_getAlgorithmTypeUnlocked()) {
             case SchedulerAlgorithmType::fcfs:
                 _runFCFSLogic(lock);
@@ -592,6 +709,199 @@ void Scheduler::runSchedulingLoop() {
     std::cout << "[Scheduler] Exiting scheduling loop.\n";
 }
 
+void Scheduler::_dispatchProcessToCoreUnlocked(std::shared_ptr<Process> proc, int coreId) {
+    proc->setCpuCoreExecuting(coreId);
+    proc->setStatus(ProcessStatus::RUNNING);
+    coreAvailable[coreId] = false;
+    coreAssignments[coreId] = proc;
+    proc->addLogEntry("(" + getCurrentTimestamp() + ") Core:" + std::to_string(coreId) +
+        " Process " + proc->getProcessName() + " (PID:" + proc->getPid() + ") dispatched.");
+}
+
+bool Scheduler::popOrStealProcess(int coreId, std::shared_ptr<Process>& out) {
+    if (processQueues[coreId]->pop(out)) {
+        return true;
+    }
+    for (int k = 1; k < numCores; ++k) {
+        if (processQueues[(coreId + k) % numCores]->steal(out)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Scheduler::_dispatchToCoreWorkersUnlocked() {
+    // FCFS workers pull from their own deque (or steal) without going through the dispatcher,
+    // and charge no idle ticks here.
+    if (_getAlgorithmTypeUnlocked() != SchedulerAlgorithmType::rr) return;
+
+    long long now = _getSimulatedTimeUnlocked();
+    for (int i = 0; i < numCores; ++i) {
+        if (!coreAvailable[i]) continue;
+
+        // Passes of this loop come at wall-clock intervals, so an idle core is charged for the
+        // simulated time it has sat idle instead of one tick a pass. Every core's instructions
+        // advance that clock, so a core's share of it is 1 / numCores.
+        long long idle = (now - coreIdleSince[i]) / numCores;
+        coreIdleSince[i] += idle * numCores;
+        if (idle > 0) {
+            idleCpuTicks.fetch_add(idle);
+            totalCpuTicks.fetch_add(idle);
+        }
+
+        std::shared_ptr<Process> nextProc = nullptr;
+        if (!_popRunnableUnlocked(nextProc)) continue;
+
+        _dispatchProcessToCoreUnlocked(nextProc, i);
+
+        CoreWorker& worker = *coreWorkers[i];
+        {
+            std::lock_guard<std::mutex> workerLock(worker.mtx);
+            worker.process = nextProc;
+        }
+        worker.cv.notify_one();
+    }
+}
+
+void Scheduler::runCoreWorker(int coreId) {
+    if (_getAlgorithmTypeUnlocked() == SchedulerAlgorithmType::fcfs) {
+        runFCFSCoreWorker(coreId);
+        return;
+    }
+
+    CoreWorker& worker = *coreWorkers[coreId];
+    std::shared_ptr<Process> proc;
+
+    while (true) {
+        if (!proc) {
+            std::unique_lock<std::mutex> workerLock(worker.mtx);
+            worker.cv.wait(workerLock, [&] {
+                return worker.process != nullptr || !running.load(std::memory_order_relaxed);
+            });
+            if (!running.load(std::memory_order_relaxed)) break;
+            proc = std::move(worker.process);
+        }
+
+        _executeSlice(proc, coreId, (quantumCycles > 0) ? quantumCycles : 3);
+
+        std::lock_guard<std::mutex> lock(mtx);
+        _completeSliceUnlocked(proc, coreId);
+        bool stopped = proc->getStatus() != ProcessStatus::READY;
+
+        // The core picks its own next process while it holds mtx anyway; the scheduling thread
+        // only dispatches to idle cores, so it is woken when this core goes idle, its process
+        // stopped (memory freed, a sleeper), or other idle cores could take queued work.
+        proc = nullptr;
+        if (running.load(std::memory_order_relaxed) && _popRunnableUnlocked(proc)) {
+            _dispatchProcessToCoreUnlocked(proc, coreId);
+        }
+        if (stopped || !proc || (!globalQueue.empty() && _getCoresAvailableUnlocked() > 0)) {
+            cv.notify_all();
+        }
+    }
+}
+
+void Scheduler::runFCFSCoreWorker(int coreId) {
+    CoreWorker& worker = *coreWorkers[coreId];
+
+    while (running.load(std::memory_order_acquire)) {
+        unsigned long long seenWork = stealableWork.load(std::memory_order_acquire);
+        drainCoreInbox(coreId);
+
+        std::shared_ptr<Process> proc;
+        fcfsInFlight.fetch_add(1);
+        if (!popOrStealProcess(coreId, proc)) {
+            fcfsInFlight.fetch_sub(1);
+            std::unique_lock<std::mutex> workerLock(worker.mtx);
+            worker.cv.wait_for(workerLock, std::chrono::milliseconds(REAL_TIME_TICK_DURATION_MS), [&] {
+                return !worker.inbox.empty()
+                    || stealableWork.load(std::memory_order_acquire) != seenWork
+                    || !running.load(std::memory_order_relaxed);
+            });
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (!running.load(std::memory_order_relaxed)) {
+                processQueues[coreId]->push(proc);
+                fcfsInFlight.fetch_sub(1);
+                break;
+            }
+            _dispatchProcessToCoreUnlocked(proc, coreId);
+        }
+        fcfsInFlight.fetch_sub(1);
+
+        // Runs until the process sleeps or terminates.
+        _executeSlice(proc, coreId, -1);
+
+        std::lock_guard<std::mutex> lock(mtx);
+        _completeSliceUnlocked(proc, coreId);
+        cv.notify_all();
+    }
+}
+
+void Scheduler::drainCoreInbox(int coreId) {
+    CoreWorker& worker = *coreWorkers[coreId];
+    if (worker.inbox.empty()) return;
+
+    fcfsInFlight.fetch_add(1);
+    size_t arrivals = worker.inbox.drain([&](std::shared_ptr<Process>&& proc) {
+        processQueues[coreId]->push(std::move(proc));
+    });
+    fcfsInFlight.fetch_sub(1);
+    if (arrivals == 0) return;
+
+    // Let idle cores know there is something to steal.
+    stealableWork.fetch_add(1, std::memory_order_release);
+    for (int i = 0; i < numCores; ++i) {
+        if (i == coreId) continue;
+        std::lock_guard<std::mutex> otherLock(coreWorkers[i]->mtx);
+        coreWorkers[i]->cv.notify_one();
+    }
+}
+
+int Scheduler::_executeSlice(std::shared_ptr<Process> proc, int coreId, int maxInstructions) {
+    int executed = 0;
+
+    // Runs in chunks of at most SLICE_FLUSH_INTERVAL so ticks and time are published as it goes.
+    while (running.load(std::memory_order_relaxed) && (maxInstructions < 0 || executed < maxInstructions)) {
+        int budget = (maxInstructions < 0) ? SLICE_FLUSH_INTERVAL : std::min(SLICE_FLUSH_INTERVAL, maxInstructions - executed);
+        SliceResult result = proc->runSlice(budget, makeSliceContext(coreId));
+        accountSlice(result);
+        executed += result.retired;
+
+        if (result.reason == SliceStopReason::SLEEP || result.reason == SliceStopReason::TERMINATED) break;
+        // A fault costs an RR process the rest of its quantum; FCFS keeps the core.
+        if (result.reason == SliceStopReason::PAGE_FAULT && maxInstructions >= 0) break;
+        if (maxInstructions < 0) {
+            // Long FCFS runs keep arrivals for this core stealable by idle cores.
+            drainCoreInbox(coreId);
+        }
+    }
+    return executed;
+}
+
+void Scheduler::_completeSliceUnlocked(std::shared_ptr<Process> proc, int coreId) {
+    if (proc->getStatus() == ProcessStatus::RUNNING) {
+        proc->setStatus(ProcessStatus::READY);
+        proc->setCpuCoreExecuting(-1);
+        if (_getAlgorithmTypeUnlocked() == SchedulerAlgorithmType::rr) {
+            _enqueueReadyUnlocked(proc);
+            proc->addLogEntry("(" + getCurrentTimestamp() + ") Core:" + std::to_string(coreId) +
+                " Process " + proc->getProcessName() + " (PID:" + proc->getPid() + ") preempted, added to RR Global Queue.");
+        } else {
+            processQueues[coreId]->push(proc);
+        }
+    } else {
+        _handleStoppedProcessUnlocked(proc, coreId);
+        if (proc->getStatus() == ProcessStatus::TERMINATED && _getAlgorithmTypeUnlocked() == SchedulerAlgorithmType::fcfs) {
+            proc->setCpuCoreExecuting(-1);
+        }
+    }
+    _markCoreAvailableUnlocked(coreId);
+}
+
 void Scheduler::_runFCFSLogic(std::unique_lock<std::mutex>& lock) {
     for (int i = 0; i < numCores; ++i) {
         if (!running.load(std::memory_order_relaxed)) return;
@@ -601,21 +911,19 @@ void Scheduler::_runFCFSLogic(std::unique_lock<std::mutex>& lock) {
             std::shared_ptr<Process> proc = coreAssignments[i];
 
             if (proc->getStatus() == ProcessStatus::RUNNING) {
-                bool hasMoreCommands = executeSingleCommand(proc, i);
-                
-                // Count active CPU tick for this core
-                activeCpuTicks.fetch_add(1);
-                totalCpuTicks.fetch_add(1);
+                // Serial FCFS interleaves the cores one instruction at a time.
+                SliceResult result = proc->runSlice(1, makeSliceContext(i));
+                accountSlice(result);
 
                 if (!running.load(std::memory_order_relaxed)) return;
 
-                if (hasMoreCommands) {
-                    _advanceSimulatedTimeUnlocked(1 + delaysPerExecution);
-                } else if (proc->getStatus() == ProcessStatus::TERMINATED) {
-                    _advanceSimulatedTimeUnlocked(1 + delaysPerExecution);
-                    proc->setCpuCoreExecuting(-1);
-                    _markCoreAvailableUnlocked(i);
-                    coreFreed = true;
+                if (result.reason == SliceStopReason::SLEEP || result.reason == SliceStopReason::TERMINATED) {
+                    _handleStoppedProcessUnlocked(proc, i);
+                    if (proc->getStatus() == ProcessStatus::TERMINATED) {
+                        proc->setCpuCoreExecuting(-1);
+                        _markCoreAvailableUnlocked(i);
+                        coreFreed = true;
+                    }
                 }
             } else if (proc->getStatus() == ProcessStatus::PAUSED || proc->getStatus() == ProcessStatus::TERMINATED) {
                 if (proc->getCpuCoreExecuting() == i) {
@@ -634,22 +942,8 @@ void Scheduler::_runFCFSLogic(std::unique_lock<std::mutex>& lock) {
 
         if (coreAvailable[i] && coreFreed) {
             std::shared_ptr<Process> nextProc = nullptr;
-            int selectedQueueIdx = -1;
-            for (int q_idx = 0; q_idx < numCores; ++q_idx) {
-                if (!processQueues[q_idx].empty()) {
-                    nextProc = processQueues[q_idx].front();
-                    selectedQueueIdx = q_idx;
-                    break;
-                }
-            }
-            if (nextProc && selectedQueueIdx != -1) {
-                processQueues[selectedQueueIdx].pop();
-                nextProc->setCpuCoreExecuting(i);
-                nextProc->setStatus(ProcessStatus::RUNNING);
-                coreAvailable[i] = false;
-                coreAssignments[i] = nextProc;
-                nextProc->addLogEntry("(" + getCurrentTimestamp() + ") Core:" + std::to_string(i) +
-                    " Process " + nextProc->getProcessName() + " (PID:" + nextProc->getPid() + ") dispatched.");
+            if (popOrStealProcess(i, nextProc)) {
+                _dispatchProcessToCoreUnlocked(nextProc, i);
             }
         }
     }
@@ -661,32 +955,9 @@ void Scheduler::_runRoundRobinLogic(std::unique_lock<std::mutex>& lock) {
     auto logMemorySnapshot = [&](int quantumValue) {
     };
 
-    size_t pendingCount = rrPendingQueue.size();
-    for (size_t p = 0; p < pendingCount; ++p) {
-        auto proc = rrPendingQueue.front();
-        rrPendingQueue.pop();
-        auto memoryAllocator = ConsoleManager::getInstance()->getMemoryAllocator();
-        bool allocated = false;
-
-        if (memoryAllocator) {
-            allocated = (memoryAllocator->allocate(proc) != nullptr);
-        }
-
-        if (allocated) {
-            globalQueue.push(proc);
-            //proc->addLogEntry("(" + getCurrentTimestamp() + ") Process " + proc->getProcessName() +
-                             //" (PID:" + proc->getPid() + ") memory allocated, added to RR Global Queue.");
-        } else {
-            rrPendingQueue.push(proc);
-            //proc->addLogEntry("(" + getCurrentTimestamp() + ") Process " + proc->getProcessName() +
-                             //" (PID:" + proc->getPid() + ") failed memory allocation. Remaining in pending queue.");
-        }
-    }
-
     for (int i = 0; i < numCores; ++i) {
-        if (coreAvailable[i] && !globalQueue.empty()) {
-            auto nextProc = globalQueue.front();
-            globalQueue.pop();
+        std::shared_ptr<Process> nextProc;
+        if (coreAvailable[i] && _popRunnableUnlocked(nextProc)) {
             nextProc->setCpuCoreExecuting(i);
             nextProc->setStatus(ProcessStatus::RUNNING);
             coreAvailable[i] = false;
@@ -703,18 +974,11 @@ void Scheduler::_runRoundRobinLogic(std::unique_lock<std::mutex>& lock) {
         std::shared_ptr<Process> proc = coreAssignments[i];
         if (proc) {
             if (proc->getStatus() == ProcessStatus::RUNNING && proc->getCpuCoreExecuting() == i) {
-                int executedCommandsInSlice = 0;
-                while (executedCommandsInSlice < effectiveQuantum) {
-                    if (!running.load(std::memory_order_relaxed)) return;
-                    bool commandStillRunning = executeSingleCommand(proc, i);
-                    
-                    activeCpuTicks.fetch_add(1);
-                    totalCpuTicks.fetch_add(1);
-
-                    if (!commandStillRunning || proc->getStatus() == ProcessStatus::PAUSED || proc->getStatus() == ProcessStatus::TERMINATED)
-                        break;
-                    ++executedCommandsInSlice;
-                    _advanceSimulatedTimeUnlocked(1 + delaysPerExecution);
+                SliceResult result = proc->runSlice(effectiveQuantum, makeSliceContext(i));
+                accountSlice(result);
+
+                if (result.reason == SliceStopReason::SLEEP || result.reason == SliceStopReason::TERMINATED) {
+                    _handleStoppedProcessUnlocked(proc, i);
                 }
 
                 logMemorySnapshot(effectiveQuantum);
@@ -723,7 +987,7 @@ void Scheduler::_runRoundRobinLogic(std::unique_lock<std::mutex>& lock) {
                 if (proc->getStatus() == ProcessStatus::RUNNING) {
                     proc->setStatus(ProcessStatus::READY);
                     proc->setCpuCoreExecuting(-1);
-                    globalQueue.push(proc);
+                    _enqueueReadyUnlocked(proc);
                     proc->addLogEntry("(" + getCurrentTimestamp() + ") Core:" + std::to_string(i) +
                         " Process " + proc->getProcessName() + " (PID:" + proc->getPid() + ") preempted, added to RR Global Queue.");
                     _markCoreAvailableUnlocked(i);
@@ -747,9 +1011,7 @@ void Scheduler::_runRoundRobinLogic(std::unique_lock<std::mutex>& lock) {
         }
         if (coreAvailable[i] && coreFreed) {
             std::shared_ptr<Process> nextProc = nullptr;
-            if (!globalQueue.empty()) {
-                nextProc = globalQueue.front();
-                globalQueue.pop();
+            if (_popRunnableUnlocked(nextProc)) {
                 nextProc->setCpuCoreExecuting(i);
                 nextProc->setStatus(ProcessStatus::RUNNING);
                 coreAvailable[i] = false;
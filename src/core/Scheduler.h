@@ -1,6 +1,10 @@
 #pragma once
 
 #include "Process.h"
+#include "WorkStealingDeque.h"
+#include "MpscQueue.h"
+#include "AdmissionController.h"
+#include "WorkingSetController.h"
 
 #include <queue>
 #include <mutex>
@@ -11,6 +15,8 @@
 #include <atomic>
 #include <iostream>
 #include <map>
+#include <deque>
+#include <unordered_map>
 #include <chrono>
 #include <cstdint> 
 #include <functional>
@@ -23,10 +29,38 @@ enum class SchedulerAlgorithmType {
     rr
 };
 
+enum class SchedulerExecutionMode {
+    serial,
+    perCore
+};
+
+// realtime ties simulated ticks to the wall clock; virtualTime runs as fast as possible and
+// jumps the clock straight to the next wakeup or batch arrival whenever every core is idle.
+enum class SchedulerClockMode {
+    realtime,
+    virtualTime
+};
+
+// How an RR core picks from the ready queue: strictly in order, or preferring the process with the
+// most of its pages resident among the first few, none of which may be passed over too often.
+enum class SchedulerDispatchPolicy {
+    fifo,
+    residentFirst
+};
+
 struct SleepingProcess {
     std::shared_ptr<Process> process;
     long long wakeUpTime;
     int assignedCoreId;
+    unsigned long long sleepOrder;
+};
+
+// Min-heap order for sleepers: earliest wake-up first, ties in the order they went to sleep.
+struct WakesLater {
+    bool operator()(const SleepingProcess& a, const SleepingProcess& b) const {
+        if (a.wakeUpTime != b.wakeUpTime) return a.wakeUpTime > b.wakeUpTime;
+        return a.sleepOrder > b.sleepOrder;
+    }
 };
 
 class Scheduler {
@@ -43,6 +77,12 @@ public:
     void setAlgorithmType(SchedulerAlgorithmType type);
     SchedulerAlgorithmType getAlgorithmType() const;
 
+    void setExecutionMode(SchedulerExecutionMode mode);
+    SchedulerExecutionMode getExecutionMode() const;
+
+    void setClockMode(SchedulerClockMode mode);
+    SchedulerClockMode getClockMode() const;
+
     int getTotalCores() const;
     int getCoresUsed() const;
     int getCoresAvailable() const;
@@ -66,11 +106,29 @@ public:
     using ProcessTerminationCallback = std::function<void(std::shared_ptr<Process>)>;
     void setProcessTerminationCallback(ProcessTerminationCallback callback);
 
-    void addProcessToRRPendingQueue(std::shared_ptr<Process> process) {
-        std::lock_guard<std::mutex> lock(mtx);
-        rrPendingQueue.push(process);
-        cv.notify_all(); 
-    }
+    void addProcessToRRPendingQueue(std::shared_ptr<Process> process);
+
+    // A process is passed over by resident-first dispatch at most maxBypass times.
+    void setDispatchPolicy(SchedulerDispatchPolicy policy, uint32_t maxBypass);
+    struct DispatchStats {
+        SchedulerDispatchPolicy policy = SchedulerDispatchPolicy::fifo;
+        long long dispatches = 0;
+        long long outOfOrder = 0;       // a process other than the head was picked
+        long long forced = 0;           // the bypass limit overrode residency
+        long long totalReadyWait = 0;   // ticks between becoming ready and being dispatched
+        long long maxReadyWait = 0;
+    };
+    DispatchStats getDispatchStats() const;
+
+    // RR load control against a budget of frames; 0 turns it off.
+    void setWorkingSetFrameBudget(size_t frames);
+    WorkingSetController::Stats getWorkingSetStats() const;
+
+    // Virtual-time batch arrivals: while started, the scheduling loop calls the generator every interval ticks.
+    using ArrivalGenerator = std::function<void()>;
+    void setArrivalGenerator(ArrivalGenerator generator);
+    void startArrivals(long long interval);
+    void stopArrivals();
 
 private:
     void runSchedulingLoop();
@@ -78,6 +136,19 @@ private:
     void _runFCFSLogic(std::unique_lock<std::mutex>& lock);
     void _runRoundRobinLogic(std::unique_lock<std::mutex>& lock);
 
+    // Per-core execution: the scheduling loop only dispatches, each core's worker runs its own slices.
+    void runCoreWorker(int coreId);
+    void runFCFSCoreWorker(int coreId);
+    void _dispatchToCoreWorkersUnlocked();
+    void _dispatchProcessToCoreUnlocked(std::shared_ptr<Process> proc, int coreId);
+    bool popOrStealProcess(int coreId, std::shared_ptr<Process>& out);
+    void drainCoreInbox(int coreId);
+    int _executeSlice(std::shared_ptr<Process> proc, int coreId, int maxInstructions);
+    SliceContext makeSliceContext(int coreId);
+    void accountSlice(const SliceResult& result);
+    void _completeSliceUnlocked(std::shared_ptr<Process> proc, int coreId);
+    void _handleStoppedProcessUnlocked(std::shared_ptr<Process> proc, int coreId);
+
     void _markCoreAvailableUnlocked(int core);
     void _addProcessUnlocked(std::shared_ptr<Process> process);
     void _setAlgorithmTypeUnlocked(SchedulerAlgorithmType type);
@@ -89,27 +160,80 @@ private:
     void _checkSleepingProcessesUnlocked();
     bool _sleepQuickScan() const;
     bool _areAllQueuesEmptyUnlocked() const;
+    void _drainSubmissionsUnlocked();
+    void _admitPendingUnlocked();
+    void _enqueueReadyUnlocked(std::shared_ptr<Process> process);
+    bool _popRunnableUnlocked(std::shared_ptr<Process>& out);
+    size_t _chooseDispatchUnlocked();
+
+    void runDueArrivals();
+    bool _isIdleUnlocked() const;
+    bool _advanceToNextEventUnlocked();
 
     std::string getCurrentTimestamp();
 
     int numCores;
     std::vector<bool> coreAvailable;
-    std::vector<std::queue<std::shared_ptr<Process>>> processQueues;
-    std::queue<std::shared_ptr<Process>> globalQueue;
-    std::queue<std::shared_ptr<Process>> rrPendingQueue;
+    // FCFS ready processes, one work-stealing deque per core.
+    std::vector<std::unique_ptr<WorkStealingDeque<std::shared_ptr<Process>>>> processQueues;
+    // RR ready processes; a deque so resident-first dispatch can look past the head.
+    std::deque<std::shared_ptr<Process>> globalQueue;
+    // RR processes waiting for memory; retried only when memory is released or one arrives.
+    AdmissionController rrPendingAdmissions;
+    WorkingSetController workingSetControl;
+
+    struct ReadyState {
+        long long readySince;
+        uint32_t bypassed;
+    };
+    SchedulerDispatchPolicy dispatchPolicy;
+    uint32_t maxDispatchBypass;
+    std::unordered_map<const Process*, ReadyState> readyStates;
+    DispatchStats dispatchStats;
     int nextCoreForNewProcess;
 
     mutable std::mutex mtx;
     mutable std::condition_variable cv;
     std::unique_ptr<std::thread> schedulerThread;
     std::atomic<bool> running;
-    SchedulerAlgorithmType currentAlgorithm;
-
-    std::vector<SleepingProcess> sleepingProcesses;
-    long long simulatedTime;
+    std::atomic<SchedulerAlgorithmType> currentAlgorithm;
+
+    // Producers (console, batch generator) never take mtx; the scheduling loop drains this each pass.
+    struct ProcessSubmission {
+        std::shared_ptr<Process> process;
+        bool awaitingMemory;
+    };
+    MpscQueue<ProcessSubmission> submissions;
+
+    struct CoreWorker {
+        std::thread thread;
+        std::mutex mtx;
+        std::condition_variable cv;
+        std::shared_ptr<Process> process;
+
+        // FCFS arrivals routed to this core; only the owning worker moves them into its deque.
+        MpscQueue<std::shared_ptr<Process>> inbox;
+    };
+
+    SchedulerExecutionMode executionMode;
+    std::vector<std::unique_ptr<CoreWorker>> coreWorkers;
+    std::atomic<unsigned long long> stealableWork;
+    // FCFS processes a worker has taken out of its inbox or a deque but not yet dispatched;
+    // the virtual clock must not skip ahead while any are in flight.
+    std::atomic<int> fcfsInFlight;
+
+    std::priority_queue<SleepingProcess, std::vector<SleepingProcess>, WakesLater> sleepingProcesses;
+    unsigned long long nextSleepOrder;
+    std::atomic<long long> simulatedTime;
+
+    SchedulerClockMode clockMode;
+    ArrivalGenerator arrivalGenerator;
+    std::atomic<long long> arrivalInterval;
+    std::atomic<long long> nextArrivalTime;
     std::vector<std::shared_ptr<Process>> coreAssignments;
+    // Simulated time up to which each idle per-core RR core has been charged idle ticks.
+    std::vector<long long> coreIdleSince;
 
-    bool executeSingleCommand(std::shared_ptr<Process> proc, int coreId);
     uint32_t delaysPerExecution;
     uint32_t quantumCycles;
     
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Chase-Lev work-stealing deque (Le, Pop, Cohen, Zappa Nardelli, PPoPP'13 memory orderings).
+// The owning core pushes and pops at the bottom; any other core may steal from the top.
+// Values are boxed so the ring only ever holds raw pointers, which keeps the
+// read-then-CAS in steal() free of data races for non-trivial types like shared_ptr.
+template <typename T>
+class WorkStealingDeque {
+public:
+    explicit WorkStealingDeque(size_t initialCapacity = 64)
+        : top(0), bottom(0), buffer(new Buffer(roundUpToPowerOfTwo(initialCapacity))) {}
+
+    ~WorkStealingDeque() {
+        clear();
+        delete buffer.load(std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // Owner only.
+    void push(T value) {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_acquire);
+        Buffer* a = buffer.load(std::memory_order_relaxed);
+
+        if (b - t > static_cast<int64_t>(a->capacity) - 1) {
+            Buffer* bigger = a->grow(t, b);
+            retiredBuffers.emplace_back(a);
+            buffer.store(bigger, std::memory_order_release);
+            a = bigger;
+        }
+
+        a->put(b, new T(std::move(value)));
+        bottom.store(b + 1, std::memory_order_release);
+    }
+
+    // Owner only. Takes the most recently pushed value.
+    bool pop(T& out) {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* a = buffer.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        T* box = a->get(b);
+        if (t == b) {
+            // Last element: race any thief for it.
+            bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            if (!won) return false;
+        }
+        return unbox(box, out);
+    }
+
+    // Any thread. Takes the oldest value; fails if empty or if another thread won the race.
+    bool steal(T& out) {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_acquire);
+
+        if (t >= b) return false;
+
+        Buffer* a = buffer.load(std::memory_order_acquire);
+        T* box = a->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return false;
+        }
+        return unbox(box, out);
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    size_t size() const {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_relaxed);
+        return b > t ? static_cast<size_t>(b - t) : 0;
+    }
+
+    // Owner only, with no concurrent thieves.
+    void clear() {
+        T discarded;
+        while (pop(discarded)) {}
+        retiredBuffers.clear();
+    }
+
+private:
+    struct Buffer {
+        size_t capacity;
+        size_t mask;
+        std::unique_ptr<std::atomic<T*>[]> slots;
+
+        explicit Buffer(size_t cap) : capacity(cap), mask(cap - 1), slots(new std::atomic<T*>[cap]) {}
+
+        T* get(int64_t index) const {
+            return slots[static_cast<size_t>(index) & mask].load(std::memory_order_relaxed);
+        }
+
+        void put(int64_t index, T* value) {
+            slots[static_cast<size_t>(index) & mask].store(value, std::memory_order_relaxed);
+        }
+
+        Buffer* grow(int64_t t, int64_t b) const {
+            Buffer* bigger = new Buffer(capacity * 2);
+            for (int64_t i = t; i < b; ++i) {
+                bigger->put(i, get(i));
+            }
+            return bigger;
+        }
+    };
+
+    static size_t roundUpToPowerOfTwo(size_t n) {
+        size_t cap = 2;
+        while (cap < n) cap <<= 1;
+        return cap;
+    }
+
+    static bool unbox(T* box, T& out) {
+        out = std::move(*box);
+        delete box;
+        return true;
+    }
+
+    alignas(64) std::atomic<int64_t> top;
+    alignas(64) std::atomic<int64_t> bottom;
+    std::atomic<Buffer*> buffer;
+
+    // Thieves may still be reading a buffer after it has been outgrown, so old ones live until clear().
+    std::vector<std::unique_ptr<Buffer>> retiredBuffers;
+};
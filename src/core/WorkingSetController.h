@@ -0,0 +1,138 @@
+#pragma once
+
+#include "Process.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <vector>
+
+// Load control for the paging allocator. While the working sets of the admitted processes add up
+// to more than the frames, the one faulting most often is suspended: it is parked when next
+// dispatched, and its pages age out to the others. Suspended processes resume oldest first once
+// their working set fits again, and new admissions wait until none are left suspended.
+class WorkingSetController {
+public:
+    struct Stats {
+        bool enabled = false;
+        bool thrashing = false;
+        size_t demand = 0;          // sum of the running (not suspended) processes' working sets
+        size_t frames = 0;
+        size_t active = 0;
+        size_t suspended = 0;
+        long long suspensions = 0;
+        long long resumes = 0;
+    };
+
+    WorkingSetController() : frames(0), thrashing(false), suspensions(0), resumes(0) {}
+
+    // 0 frames disables load control.
+    void setFrameBudget(size_t frameCount) { frames = frameCount; }
+    bool enabled() const { return frames > 0; }
+    bool admitting() const { return !enabled() || (!thrashing && suspended.empty()); }
+
+    void onAdmitted(std::shared_ptr<Process> process) {
+        if (enabled()) active.push_back(std::move(process));
+    }
+
+    void onTerminated(const Process& process) {
+        auto matches = [&](const std::shared_ptr<Process>& p) { return p.get() == &process; };
+        active.erase(std::remove_if(active.begin(), active.end(), matches), active.end());
+        suspended.erase(std::remove_if(suspended.begin(), suspended.end(),
+            [&](const Suspension& s) { return s.process.get() == &process; }), suspended.end());
+    }
+
+    bool isSuspended(const Process& process) const {
+        return std::any_of(suspended.begin(), suspended.end(), [&](const Suspension& s) { return s.process.get() == &process; });
+    }
+
+    // A suspended process came up for dispatch; it stays here until resumed.
+    void park(std::shared_ptr<Process> process) {
+        for (Suspension& s : suspended) {
+            if (s.process == process) s.parked = true;
+        }
+    }
+
+    // Suspends or resumes at most one process. resume(process) is handed a parked process to requeue.
+    // Returns true when the pressure has just dropped enough to admit again.
+    template <typename Resume>
+    bool rebalance(Resume&& resume) {
+        if (!enabled()) return false;
+        bool wasAdmitting = admitting();
+
+        size_t demand = demandOfRunning();
+        thrashing = demand > frames;
+        if (thrashing) {
+            // Always leave one process running so the system makes progress.
+            if (active.size() - suspended.size() > 1) {
+                std::shared_ptr<Process> victim;
+                for (const auto& process : active) {
+                    if (isSuspended(*process)) continue;
+                    if (!victim || faultierThan(*process, *victim)) victim = process;
+                }
+                suspended.push_back(Suspension{victim, false});
+                ++suspensions;
+            }
+        } else if (!suspended.empty()) {
+            Suspension& oldest = suspended.front();
+            bool nothingRunning = active.size() == suspended.size();
+            if (nothingRunning || demand + std::max<size_t>(oldest.process->getWorkingSet().getSize(), 1) <= frames) {
+                Suspension resumed = oldest;
+                suspended.pop_front();
+                ++resumes;
+                if (resumed.parked) resume(resumed.process);
+            }
+        }
+
+        return !wasAdmitting && admitting();
+    }
+
+    Stats getStats() const {
+        Stats stats;
+        stats.enabled = enabled();
+        stats.thrashing = thrashing;
+        stats.demand = enabled() ? demandOfRunning() : 0;
+        stats.frames = frames;
+        stats.active = active.size();
+        stats.suspended = suspended.size();
+        stats.suspensions = suspensions;
+        stats.resumes = resumes;
+        return stats;
+    }
+
+    void clear() {
+        active.clear();
+        suspended.clear();
+        thrashing = false;
+    }
+
+private:
+    struct Suspension {
+        std::shared_ptr<Process> process;
+        bool parked;
+    };
+
+    size_t frames;
+    bool thrashing;
+    std::vector<std::shared_ptr<Process>> active;
+    std::deque<Suspension> suspended;   // oldest first
+    long long suspensions;
+    long long resumes;
+
+    size_t demandOfRunning() const {
+        size_t demand = 0;
+        for (const auto& process : active) {
+            // A process that has not referenced anything yet still holds its first page.
+            if (!isSuspended(*process)) demand += std::max<size_t>(process->getWorkingSet().getSize(), 1);
+        }
+        return demand;
+    }
+
+    static bool faultierThan(const Process& a, const Process& b) {
+        double fa = a.getWorkingSet().getFaultFrequency();
+        double fb = b.getWorkingSet().getFaultFrequency();
+        if (fa != fb) return fa > fb;
+        return a.getWorkingSet().getSize() > b.getWorkingSet().getSize();
+    }
+};
@@ -1,90 +1,181 @@
 #include "memory/BackingStore.h"
 #include <fstream>
-#include <sstream>
 #include <iomanip>
 #include <iostream>
-#include <filesystem>
+#include <mutex>
+#include <unordered_map>
+#include <algorithm>
+#include <tuple>
+
+namespace {
+
+const char* const BACKING_STORE_FILE = "csopesy-backing-store.txt";
+const uint32_t INITIAL_SLOTS = 256;
+
+struct StoreState {
+    std::mutex mtx;
+    std::fstream file;
+    size_t pageSize = 0;
+    uint32_t slotCapacity = 0;
+    std::unordered_map<std::string, std::unordered_map<int, uint32_t>> slotIndex;
+    std::vector<uint32_t> freeSlots;
+};
+
+StoreState& store() {
+    static StoreState state;
+    return state;
+}
+
+// Extends the file to newCapacity slots and hands the new ones to the free list,
+// lowest slot on top so the file fills front to back.
+void growUnlocked(StoreState& s, uint32_t newCapacity) {
+    s.file.clear();
+    s.file.seekp(static_cast<std::streamoff>(newCapacity) * s.pageSize - 1);
+    s.file.put('\0');
+    s.file.flush();
+
+    for (uint32_t slot = newCapacity; slot > s.slotCapacity; --slot) {
+        s.freeSlots.push_back(slot - 1);
+    }
+    s.slotCapacity = newCapacity;
+}
+
+void resetUnlocked(StoreState& s, size_t pageSize) {
+    if (s.file.is_open()) {
+        s.file.close();
+    }
+    s.file.open(BACKING_STORE_FILE, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!s.file.is_open()) {
+        std::cerr << "[ERROR] Could not open backing store file " << BACKING_STORE_FILE << std::endl;
+    }
+
+    s.pageSize = std::max<size_t>(pageSize, 1);
+    s.slotCapacity = 0;
+    s.slotIndex.clear();
+    s.freeSlots.clear();
+    growUnlocked(s, INITIAL_SLOTS);
+}
+
+std::streamoff slotOffset(const StoreState& s, uint32_t slot) {
+    return static_cast<std::streamoff>(slot) * s.pageSize;
+}
+
+} // namespace
+
+void BackingStore::reset(size_t pageSize) {
+    StoreState& s = store();
+    std::lock_guard<std::mutex> lock(s.mtx);
+    resetUnlocked(s, pageSize);
+}
 
 void BackingStore::pageOut(const std::string& processName, int pageNumber, const std::vector<uint8_t>& pageData) {
-   //std::cout << "[DEBUG] BackingStore::pageOut called for process " << processName << " page " << pageNumber << std::endl;
-    std::ofstream outFile("csopesy-backing-store.txt", std::ios::app);
-    if (outFile.is_open()) {
-        outFile << processName << " " << pageNumber;
-        for (auto byte : pageData) {
-            outFile << " " << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(byte);
-        }
-        outFile << "\n";
-        outFile.close();
-        //std::cout << "[DEBUG] Successfully wrote to backing store file" << std::endl;
+    StoreState& s = store();
+    std::lock_guard<std::mutex> lock(s.mtx);
+    if (s.pageSize == 0) {
+        resetUnlocked(s, pageData.size());
+    }
+
+    auto& pages = s.slotIndex[processName];
+    auto found = pages.find(pageNumber);
+    uint32_t slot;
+    if (found != pages.end()) {
+        slot = found->second;
     } else {
-        //std::cout << "[DEBUG] Failed to open backing store file for writing" << std::endl;
+        if (s.freeSlots.empty()) {
+            growUnlocked(s, s.slotCapacity * 2);
+        }
+        slot = s.freeSlots.back();
+        s.freeSlots.pop_back();
+        pages[pageNumber] = slot;
+    }
+
+    std::vector<uint8_t> slotData(s.pageSize, 0);
+    std::copy_n(pageData.begin(), std::min(pageData.size(), s.pageSize), slotData.begin());
+
+    s.file.clear();
+    s.file.seekp(slotOffset(s, slot));
+    s.file.write(reinterpret_cast<const char*>(slotData.data()), static_cast<std::streamsize>(slotData.size()));
+    if (!s.file) {
+        std::cerr << "[ERROR] Backing store write failed for " << processName << " page " << pageNumber << std::endl;
     }
 }
 
 std::vector<uint8_t> BackingStore::pageIn(const std::string& processName, int pageNumber) {
-    std::ifstream inFile("csopesy-backing-store.txt");
-    std::string line;
-    while (std::getline(inFile, line)) {
-        std::istringstream iss(line);
-        std::string name;
-        int page;
-        iss >> name >> page;
-        if (name == processName && page == pageNumber) {
-            std::vector<uint8_t> data;
-            std::string hexByte;
-            while (iss >> hexByte) {
-                data.push_back(static_cast<uint8_t>(std::stoi(hexByte, nullptr, 16)));
-            }
-            return data;
-        }
+    StoreState& s = store();
+    std::lock_guard<std::mutex> lock(s.mtx);
+
+    auto process = s.slotIndex.find(processName);
+    if (process == s.slotIndex.end()) return {};
+    auto found = process->second.find(pageNumber);
+    if (found == process->second.end()) return {};
+
+    std::vector<uint8_t> data(s.pageSize);
+    s.file.clear();
+    s.file.seekg(slotOffset(s, found->second));
+    s.file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    if (!s.file) {
+        std::cerr << "[ERROR] Backing store read failed for " << processName << " page " << pageNumber << std::endl;
+        return {};
+    }
+    return data;
+}
+
+void BackingStore::release(const std::string& processName) {
+    StoreState& s = store();
+    std::lock_guard<std::mutex> lock(s.mtx);
+
+    auto process = s.slotIndex.find(processName);
+    if (process == s.slotIndex.end()) return;
+    for (const auto& entry : process->second) {
+        s.freeSlots.push_back(entry.second);
     }
-    return {}; 
+    s.slotIndex.erase(process);
 }
 
 void BackingStore::displayStatus() {
+    StoreState& s = store();
+    std::lock_guard<std::mutex> lock(s.mtx);
+
     std::cout << "\n--- Backing Store Status ---" << std::endl;
-    std::ifstream inFile("csopesy-backing-store.txt");
-    if (!inFile.is_open()) {
+    if (!s.file.is_open()) {
         std::cout << "Backing store file not found or could not be opened." << std::endl;
         return;
     }
-    
-    std::string line;
-    int pageCount = 0;
-    std::cout << std::left << std::setw(12) << "Process" 
-              << std::setw(8) << "Page#" 
+
+    // Listed in file order, which is also the order the slots were first handed out.
+    std::vector<std::tuple<uint32_t, std::string, int>> used;
+    for (const auto& [processName, pages] : s.slotIndex) {
+        for (const auto& [pageNumber, slot] : pages) {
+            used.emplace_back(slot, processName, pageNumber);
+        }
+    }
+    std::sort(used.begin(), used.end());
+
+    std::cout << std::left << std::setw(12) << "Process"
+              << std::setw(8) << "Page#"
               << "Data (first 8 bytes)" << std::endl;
     std::cout << std::string(50, '-') << std::endl;
-    
-    while (std::getline(inFile, line) && pageCount < 20) { 
-        if (line.empty()) continue;
-        
-        std::istringstream iss(line);
-        std::string processName;
-        int pageNumber;
-        iss >> processName >> pageNumber;
-        
-        std::cout << std::left << std::setw(12) << processName 
+
+    size_t previewBytes = std::min<size_t>(8, s.pageSize);
+    std::vector<uint8_t> preview(previewBytes);
+    for (size_t i = 0; i < used.size() && i < 20; ++i) {
+        const auto& [slot, processName, pageNumber] = used[i];
+        std::cout << std::left << std::setw(12) << processName
                   << std::setw(8) << pageNumber;
-        
-        std::string hexByte;
-        for (int i = 0; i < 8 && iss >> hexByte; ++i) {
-            std::cout << hexByte << " ";
+
+        s.file.clear();
+        s.file.seekg(slotOffset(s, slot));
+        s.file.read(reinterpret_cast<char*>(preview.data()), static_cast<std::streamsize>(previewBytes));
+        for (uint8_t byte : preview) {
+            std::cout << std::right << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(byte) << " ";
         }
-        std::cout << std::endl;
-        pageCount++;
+        std::cout << std::dec << std::setfill(' ') << std::endl;
     }
-    
-    if (pageCount == 0) {
+
+    if (used.empty()) {
         std::cout << "No pages currently in backing store." << std::endl;
     } else {
-        inFile.clear();
-        inFile.seekg(0);
-        int totalPages = 0;
-        while (std::getline(inFile, line)) {
-            if (!line.empty()) totalPages++;
-        }
-        std::cout << "\nTotal pages in backing store: " << totalPages << std::endl;
+        std::cout << "\nTotal pages in backing store: " << used.size() << std::endl;
+        std::cout << "Slots in use: " << used.size() << " / " << s.slotCapacity << std::endl;
     }
-    inFile.close();
-}
\ No newline at end of file
+}
@@ -3,10 +3,20 @@
 #include <string>
 #include <vector>
 #include <cstdint>
+#include <cstddef>
 
+// Binary, slot-addressed swap file. Every (process, page) owns one fixed-size slot, so
+// page-in and page-out are a single positioned read or write regardless of file age.
 class BackingStore {
 public:
+    // Truncates the file, forgets every slot and fixes the slot size for the new session.
+    static void reset(size_t pageSize);
+
     static void pageOut(const std::string& processName, int pageNumber, const std::vector<uint8_t>& pageData);
     static std::vector<uint8_t> pageIn(const std::string& processName, int pageNumber);
+
+    // Returns every slot held by the process to the free list.
+    static void release(const std::string& processName);
+
     static void displayStatus();
-};
\ No newline at end of file
+};
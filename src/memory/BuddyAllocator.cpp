@@ -0,0 +1,191 @@
+#include "memory/BuddyAllocator.h"
+
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+
+BuddyAllocator::BuddyAllocator(size_t totalMemorySize, size_t minBlockSize)
+    : minBlockSize(std::max<size_t>(minBlockSize, 2)),
+      totalUnits(totalMemorySize / this->minBlockSize),
+      memory(totalUnits * this->minBlockSize, 0),
+      blocks(totalUnits),
+      freeUnits(0),
+      allocatedBlocks(0),
+      requestedBytes(0) {
+    int maxOrder = 0;
+    while ((static_cast<size_t>(2) << maxOrder) <= totalUnits) ++maxOrder;
+    freeBlocks.resize(maxOrder + 1);
+
+    // Greedy carving from offset 0 keeps every seed block aligned to its own size.
+    size_t unit = 0;
+    for (int order = maxOrder; order >= 0; --order) {
+        size_t size = static_cast<size_t>(1) << order;
+        if (totalUnits - unit >= size) {
+            freeBlocks[order].insert(unit);
+            unit += size;
+        }
+    }
+    freeUnits = unit;
+}
+
+void* BuddyAllocator::allocate(std::shared_ptr<Process> process) {
+    if (process->getMemoryHandle() >= 0) {
+        return memory.data() + static_cast<size_t>(process->getMemoryHandle()) * minBlockSize;
+    }
+
+    uint32_t memoryRequired = process->getMemoryRequired();
+    size_t unitsNeeded = std::max<size_t>((memoryRequired + minBlockSize - 1) / minBlockSize, 1);
+    int order = 0;
+    while ((static_cast<size_t>(1) << order) < unitsNeeded) ++order;
+
+    size_t unit;
+    {
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        int found = order;
+        while (found < static_cast<int>(freeBlocks.size()) && freeBlocks[found].empty()) ++found;
+        if (found >= static_cast<int>(freeBlocks.size())) {
+            return nullptr;
+        }
+
+        unit = *freeBlocks[found].begin();
+        freeBlocks[found].erase(freeBlocks[found].begin());
+        // Split down to the requested order, returning each upper half to its free list.
+        while (found > order) {
+            --found;
+            freeBlocks[found].insert(unit + (static_cast<size_t>(1) << found));
+        }
+
+        blocks[unit] = Block{order, memoryRequired};
+        freeUnits -= static_cast<size_t>(1) << order;
+        ++allocatedBlocks;
+        requestedBytes += memoryRequired;
+    }
+
+    size_t blockBytes = (static_cast<size_t>(1) << order) * minBlockSize;
+    std::fill_n(memory.begin() + unit * minBlockSize, blockBytes, 0);
+
+    process->setMemoryHandle(static_cast<int>(unit));
+    process->setMemory(memoryRequired, static_cast<uint32_t>(static_cast<size_t>(1) << order));
+    return memory.data() + unit * minBlockSize;
+}
+
+void BuddyAllocator::deallocate(std::shared_ptr<Process> process) {
+    int handle = process->getMemoryHandle();
+    if (handle < 0 || static_cast<size_t>(handle) >= totalUnits) {
+        return;
+    }
+
+    {
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        Block& block = blocks[handle];
+        if (block.order < 0) {
+            return;
+        }
+        --allocatedBlocks;
+        requestedBytes -= block.requested;
+        freeBlockUnlocked(static_cast<size_t>(handle), block.order);
+        block = Block{};
+    }
+
+    process->setMemoryHandle(-1);
+    uint32_t memoryRequired = process->getMemoryRequired();
+    process->setMemory(memoryRequired, 0);
+}
+
+void BuddyAllocator::freeBlockUnlocked(size_t unit, int order) {
+    freeUnits += static_cast<size_t>(1) << order;
+    // A buddy outside the memory, or one of another order, is never in this free list.
+    while (order + 1 < static_cast<int>(freeBlocks.size())) {
+        size_t buddy = unit ^ (static_cast<size_t>(1) << order);
+        auto found = freeBlocks[order].find(buddy);
+        if (found == freeBlocks[order].end()) break;
+        freeBlocks[order].erase(found);
+        unit = std::min(unit, buddy);
+        ++order;
+    }
+    freeBlocks[order].insert(unit);
+}
+
+size_t BuddyAllocator::locateUnlocked(const Process& process, uint32_t address) const {
+    int handle = process.getMemoryHandle();
+    if (handle < 0 || static_cast<size_t>(handle) >= totalUnits) return SIZE_MAX;
+    const Block& block = blocks[handle];
+    if (block.order < 0 || static_cast<uint64_t>(address) + 2 > block.requested) return SIZE_MAX;
+    return static_cast<size_t>(handle) * minBlockSize + address;
+}
+
+MemoryAccessResult BuddyAllocator::readWord(Process& process, int, uint32_t address, uint16_t& value) {
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    size_t base = locateUnlocked(process, address);
+    if (base == SIZE_MAX) return MemoryAccessResult::OUT_OF_RANGE;
+    value = static_cast<uint16_t>(memory[base] | (memory[base + 1] << 8));
+    return MemoryAccessResult::OK;
+}
+
+MemoryAccessResult BuddyAllocator::writeWord(Process& process, int, uint32_t address, uint16_t value) {
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    size_t base = locateUnlocked(process, address);
+    if (base == SIZE_MAX) return MemoryAccessResult::OUT_OF_RANGE;
+    memory[base] = static_cast<uint8_t>(value & 0xFF);
+    memory[base + 1] = static_cast<uint8_t>(value >> 8);
+    return MemoryAccessResult::OK;
+}
+
+void BuddyAllocator::visualizeMemory() const {
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    std::cout << "Memory Visualization (" << minBlockSize << " bytes per unit):\n";
+    for (size_t unit = 0; unit < totalUnits; ++unit) {
+        std::cout << (blocks[unit].order >= 0 ? '#' : '.');
+        if ((unit + 1) % 64 == 0) std::cout << '\n';
+    }
+    std::cout << '\n';
+
+    std::cout << "Free Blocks: ";
+    for (size_t order = 0; order < freeBlocks.size(); ++order) {
+        if (freeBlocks[order].empty()) continue;
+        std::cout << freeBlocks[order].size() << "x" << (minBlockSize << order) << "B ";
+    }
+    std::cout << std::endl;
+}
+
+size_t BuddyAllocator::getAllocatedBlockCount() const {
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    return allocatedBlocks;
+}
+
+size_t BuddyAllocator::getFreeBlockCount() const {
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    size_t count = 0;
+    for (const auto& list : freeBlocks) count += list.size();
+    return count;
+}
+
+size_t BuddyAllocator::getFreeBytes() const {
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    return freeUnits * minBlockSize;
+}
+
+size_t BuddyAllocator::getLargestFreeBlock() const {
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    return largestFreeUnitsUnlocked() * minBlockSize;
+}
+
+double BuddyAllocator::getExternalFragmentation() const {
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    if (freeUnits == 0) return 0.0;
+    return 1.0 - static_cast<double>(largestFreeUnitsUnlocked()) / freeUnits;
+}
+
+double BuddyAllocator::getInternalFragmentation() const {
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    size_t allocatedBytes = (totalUnits - freeUnits) * minBlockSize;
+    if (allocatedBytes == 0) return 0.0;
+    return 1.0 - static_cast<double>(requestedBytes) / allocatedBytes;
+}
+
+size_t BuddyAllocator::largestFreeUnitsUnlocked() const {
+    for (int order = static_cast<int>(freeBlocks.size()) - 1; order >= 0; --order) {
+        if (!freeBlocks[order].empty()) return static_cast<size_t>(1) << order;
+    }
+    return 0;
+}
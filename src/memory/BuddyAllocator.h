@@ -0,0 +1,58 @@
+#pragma once
+
+#include "memory/IMemoryAllocator.h"
+#include "core/Process.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <shared_mutex>
+#include <vector>
+
+// Binary buddy allocator: each process gets one contiguous block of minBlockSize << order bytes,
+// found and freed in O(log n) through per-order free lists, with freed buddies coalesced back up.
+// A memory size that is not a power of two is covered by the largest aligned blocks that fit.
+class BuddyAllocator : public IMemoryAllocator {
+public:
+    BuddyAllocator(size_t totalMemorySize, size_t minBlockSize);
+
+    void* allocate(std::shared_ptr<Process> process) override;
+    void deallocate(std::shared_ptr<Process> process) override;
+    void visualizeMemory() const override;
+    MemoryAccessResult readWord(Process& process, int coreId, uint32_t address, uint16_t& value) override;
+    MemoryAccessResult writeWord(Process& process, int coreId, uint32_t address, uint16_t value) override;
+
+    size_t getMinBlockSize() const { return minBlockSize; }
+    size_t getAllocatedBlockCount() const;
+    size_t getFreeBlockCount() const;
+    size_t getFreeBytes() const;
+    size_t getLargestFreeBlock() const;
+    // 1 - largest free block / free bytes: how much of the free memory no single request can use.
+    double getExternalFragmentation() const;
+    // Share of allocated block bytes beyond what the processes asked for.
+    double getInternalFragmentation() const;
+
+private:
+    struct Block {
+        int order = -1;             // -1 unless a block allocated to a process starts at this unit
+        uint32_t requested = 0;
+    };
+
+    size_t minBlockSize;
+    size_t totalUnits;
+    std::vector<uint8_t> memory;
+
+    // Workers read and write their own blocks under a shared lock; allocate and deallocate take it exclusively.
+    mutable std::shared_mutex mtx;
+    // Offsets, in min-block units, of the free blocks of each order.
+    std::vector<std::set<size_t>> freeBlocks;
+    std::vector<Block> blocks;      // indexed by unit; the process's memory handle is its block's unit
+    size_t freeUnits;
+    size_t allocatedBlocks;
+    size_t requestedBytes;
+
+    void freeBlockUnlocked(size_t unit, int order);
+    // Returns the first byte of the process's block, or SIZE_MAX if [address, address + 2) is outside it.
+    size_t locateUnlocked(const Process& process, uint32_t address) const;
+    size_t largestFreeUnitsUnlocked() const;
+};
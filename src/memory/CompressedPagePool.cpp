@@ -0,0 +1,159 @@
+#include "memory/CompressedPagePool.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+const size_t MIN_RUN = 3;
+const size_t MAX_RUN = 130;
+const size_t MAX_LITERALS = 128;
+
+// PackBits-style RLE: a control byte below 128 is followed by control + 1 literal bytes; one
+// of 128 or more repeats the next byte control - 125 times. Zero-filled and patterned pages
+// shrink to a few bytes, and incompressible ones grow by under one percent.
+std::vector<uint8_t> pack(const std::vector<uint8_t>& data) {
+    std::vector<uint8_t> packed;
+    packed.reserve(data.size() / 4 + 2);
+
+    size_t i = 0;
+    size_t literalStart = 0;
+    auto flushLiterals = [&](size_t end) {
+        while (literalStart < end) {
+            size_t count = std::min(MAX_LITERALS, end - literalStart);
+            packed.push_back(static_cast<uint8_t>(count - 1));
+            packed.insert(packed.end(), data.begin() + literalStart, data.begin() + literalStart + count);
+            literalStart += count;
+        }
+    };
+
+    while (i < data.size()) {
+        size_t run = 1;
+        while (i + run < data.size() && run < MAX_RUN && data[i + run] == data[i]) ++run;
+        if (run >= MIN_RUN) {
+            flushLiterals(i);
+            packed.push_back(static_cast<uint8_t>(run + 125));
+            packed.push_back(data[i]);
+            i += run;
+            literalStart = i;
+        } else {
+            i += run;
+        }
+    }
+    flushLiterals(data.size());
+    return packed;
+}
+
+std::vector<uint8_t> unpack(const std::vector<uint8_t>& packed, size_t originalSize) {
+    std::vector<uint8_t> data;
+    data.reserve(originalSize);
+
+    size_t i = 0;
+    while (i < packed.size()) {
+        uint8_t control = packed[i++];
+        if (control < 128) {
+            size_t count = std::min<size_t>(control + 1, packed.size() - i);
+            data.insert(data.end(), packed.begin() + i, packed.begin() + i + count);
+            i += count;
+        } else if (i < packed.size()) {
+            data.insert(data.end(), static_cast<size_t>(control) - 125, packed[i++]);
+        }
+    }
+    data.resize(originalSize, 0);
+    return data;
+}
+
+} // namespace
+
+CompressedPagePool::CompressedPagePool(size_t budgetBytes, WriteBehindQueue& spillTo)
+    : budgetBytes(budgetBytes),
+      spillTo(spillTo),
+      usedBytes(0),
+      bytesIn(0),
+      bytesPacked(0),
+      hits(0),
+      spills(0) {
+}
+
+void CompressedPagePool::store(const std::string& processName, int pageNumber, const std::vector<uint8_t>& pageData) {
+    std::vector<uint8_t> packed = pack(pageData);
+
+    std::lock_guard<std::mutex> lock(mtx);
+    bytesIn += static_cast<long long>(pageData.size());
+    bytesPacked += static_cast<long long>(packed.size());
+
+    PageId id(processName, pageNumber);
+    auto existing = entries.find(id);
+    if (existing != entries.end()) eraseUnlocked(existing);
+
+    if (packed.size() > budgetBytes) {
+        ++spills;
+        spillTo.enqueue(processName, pageNumber, pageData);
+        return;
+    }
+
+    // Spilled pages are queued before they leave the pool, so a concurrent load that misses
+    // here already finds them in the write-behind queue.
+    while (usedBytes + packed.size() > budgetBytes && !ageOrder.empty()) {
+        auto oldest = entries.find(ageOrder.front());
+        spillTo.enqueue(oldest->first.first, oldest->first.second, unpack(oldest->second.packed, oldest->second.originalSize));
+        ++spills;
+        eraseUnlocked(oldest);
+    }
+
+    usedBytes += packed.size();
+    ageOrder.push_back(id);
+    entries.emplace(id, Entry{std::move(packed), pageData.size(), std::prev(ageOrder.end())});
+}
+
+bool CompressedPagePool::load(const std::string& processName, int pageNumber, std::vector<uint8_t>& pageData) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto found = entries.find(PageId(processName, pageNumber));
+    if (found == entries.end()) return false;
+
+    pageData = unpack(found->second.packed, found->second.originalSize);
+    eraseUnlocked(found);
+    ++hits;
+    return true;
+}
+
+void CompressedPagePool::release(const std::string& processName) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto entry = entries.lower_bound(PageId(processName, 0));
+    while (entry != entries.end() && entry->first.first == processName) {
+        auto next = std::next(entry);
+        eraseUnlocked(entry);
+        entry = next;
+    }
+}
+
+size_t CompressedPagePool::getUsedBytes() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return usedBytes;
+}
+
+size_t CompressedPagePool::getPageCount() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return entries.size();
+}
+
+double CompressedPagePool::getCompressionRatio() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return bytesPacked > 0 ? static_cast<double>(bytesIn) / bytesPacked : 0.0;
+}
+
+long long CompressedPagePool::getHits() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return hits;
+}
+
+long long CompressedPagePool::getSpills() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return spills;
+}
+
+void CompressedPagePool::eraseUnlocked(std::map<PageId, Entry>::iterator entry) {
+    usedBytes -= entry->second.packed.size();
+    ageOrder.erase(entry->second.age);
+    entries.erase(entry);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "memory/WriteBehindQueue.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// In-memory tier between the frames and the backing store file: evicted pages are kept
+// run-length compressed within a byte budget, and only the oldest ones overflow to the file.
+// Loads are exclusive, so a page lives in at most one of the pool, the write-behind queue
+// and the file's newest copy at any time.
+class CompressedPagePool {
+public:
+    CompressedPagePool(size_t budgetBytes, WriteBehindQueue& spillTo);
+
+    CompressedPagePool(const CompressedPagePool&) = delete;
+    CompressedPagePool& operator=(const CompressedPagePool&) = delete;
+
+    bool enabled() const { return budgetBytes > 0; }
+
+    void store(const std::string& processName, int pageNumber, const std::vector<uint8_t>& pageData);
+    // Moves the page out of the pool into pageData; false if it is not pooled.
+    bool load(const std::string& processName, int pageNumber, std::vector<uint8_t>& pageData);
+    void release(const std::string& processName);
+
+    size_t getBudgetBytes() const { return budgetBytes; }
+    size_t getUsedBytes() const;
+    size_t getPageCount() const;
+    // Uncompressed over compressed size of every page stored so far.
+    double getCompressionRatio() const;
+    long long getHits() const;
+    long long getSpills() const;
+
+private:
+    using PageId = std::pair<std::string, int>;
+    struct Entry {
+        std::vector<uint8_t> packed;
+        size_t originalSize;
+        std::list<PageId>::iterator age;
+    };
+
+    size_t budgetBytes;
+    WriteBehindQueue& spillTo;
+
+    mutable std::mutex mtx;
+    std::map<PageId, Entry> entries;
+    // Oldest first; spilled from the front when the budget is exceeded.
+    std::list<PageId> ageOrder;
+    size_t usedBytes;
+    long long bytesIn;
+    long long bytesPacked;
+    long long hits;
+    long long spills;
+
+    void eraseUnlocked(std::map<PageId, Entry>::iterator entry);
+};
@@ -1,24 +1,71 @@
 #include "memory/DemandPagingAllocator.h"
 #include "memory/BackingStore.h"
+#include "memory/PageReplacementPolicies.h"
 
 #include <iostream>
 #include <algorithm>
 #include <chrono>
 #include <filesystem>
+#include <thread>
 
-DemandPagingAllocator::DemandPagingAllocator(size_t totalMemorySize, size_t frameSize, PageReplacementPolicy policy)
+// Minimum number of dirty pages that may wait for the writer before an evictor has to.
+static const size_t WRITE_BEHIND_DEPTH = 64;
+// TLB hits a core collects before handing them to the replacement policy.
+static const size_t HIT_BATCH_SIZE = 32;
+
+static std::unique_ptr<IPageReplacementPolicy> makeReplacementPolicy(DemandPagingAllocator::PageReplacementPolicy policy, size_t frameCount) {
+    switch (policy) {
+        case DemandPagingAllocator::PageReplacementPolicy::FIFO: return std::make_unique<FifoReplacementPolicy>(frameCount);
+        case DemandPagingAllocator::PageReplacementPolicy::LRU: return std::make_unique<LruReplacementPolicy>(frameCount);
+        case DemandPagingAllocator::PageReplacementPolicy::CLOCK: return std::make_unique<ClockReplacementPolicy>(frameCount);
+        case DemandPagingAllocator::PageReplacementPolicy::LFU: return std::make_unique<LfuReplacementPolicy>(frameCount);
+        case DemandPagingAllocator::PageReplacementPolicy::ARC: return std::make_unique<ArcReplacementPolicy>(frameCount);
+        case DemandPagingAllocator::PageReplacementPolicy::TWO_Q: return std::make_unique<TwoQueueReplacementPolicy>(frameCount);
+        default: return nullptr;
+    }
+}
+
+DemandPagingAllocator::DemandPagingAllocator(size_t totalMemorySize, size_t frameSize, PageReplacementPolicy policy,
+                                             size_t coreCount, size_t tlbEntries, size_t tlbWays,
+                                             size_t compressedPoolBytes)
     : frameSize(frameSize),
       totalFrames(totalMemorySize / frameSize),
       policy(policy),
-      frameTable(totalFrames, PageInfo{"", -1}),
+      replacementPolicy(makeReplacementPolicy(policy, totalMemorySize / frameSize)),
+      frameTable(totalFrames, FrameEntry{-1, -1}),
+      frameStorage(totalFrames * frameSize, 0),
+      frameDirty(totalFrames),
+      freeFrames(totalFrames),
+      nextOwner(0),
+      tlbEntries(tlbEntries),
+      tlbWays(tlbWays),
+      readaheadPages(0),
+      followStride(false),
+      workingSetWindow(0),
       totalPagesPagedIn(0),
-      totalPagesPagedOut(0) {
-    for (int i = 0; i < totalFrames; ++i) {
-        freeFrames.insert(i);
+      totalPagesPagedOut(0),
+      totalEvictions(0),
+      totalEvictionNanos(0),
+      cleanEvictions(0),
+      totalPageFaults(0),
+      pagesPrefetched(0),
+      storeReads(0),
+      writeBehind(std::max<size_t>(WRITE_BEHIND_DEPTH, totalFrames / 4)),
+      compressedPool(compressedPoolBytes, writeBehind) {
+    if (tlbEntries > 0 && tlbWays > 0 && tlbEntries % tlbWays == 0) {
+        for (size_t core = 0; core < coreCount; ++core) {
+            tlbs.push_back(std::make_unique<TranslationBuffer>(tlbEntries, tlbWays));
+            hitBuffers.push_back(std::make_unique<HitBuffer>());
+            hitBuffers.back()->hits.reserve(HIT_BATCH_SIZE);
+        }
     }
 }
 
 void* DemandPagingAllocator::allocate(std::shared_ptr<Process> process) {
+    if (process->getMemoryHandle() >= 0) {
+        return reinterpret_cast<void*>(1);
+    }
+
     std::string pid = process->getPid();
     uint32_t memoryRequired = process->getMemoryRequired();
     uint32_t pagesNeeded = (memoryRequired + frameSize - 1) / frameSize; 
@@ -29,170 +76,493 @@ void* DemandPagingAllocator::allocate(std::shared_ptr<Process> process) {
     
     uint32_t initialPages = std::min(pagesNeeded, static_cast<uint32_t>(1));
     
-    if (freeFrames.size() < initialPages) {
-        return nullptr;
+    int firstFrame = -1;
+    if (initialPages > 0) {
+        firstFrame = freeFrames.takeFirst();
+        if (firstFrame < 0) {
+            return nullptr;
+        }
     }
     
-    pageTables[pid] = std::unordered_map<int, int>();
-    
-    auto it = freeFrames.begin();
-    for (uint32_t i = 0; i < initialPages; ++i) {
-        int frameIndex = *it;
-        it = freeFrames.erase(it);
-        
-        pageTables[pid][i] = frameIndex;
-        frameTable[frameIndex] = PageInfo{pid, static_cast<int>(i)};
-
-        if (policy == PageReplacementPolicy::FIFO) {
-            fifoQueue.push_back(PageInfo{pid, static_cast<int>(i)});
+    int handle;
+    uint64_t owner;
+    ProcessPages* pages;
+    {
+        std::unique_lock<std::shared_mutex> registryLock(registryMtx);
+        if (!freeHandles.empty()) {
+            handle = freeHandles.back();
+            freeHandles.pop_back();
+        } else {
+            handle = static_cast<int>(processPages.size());
+            processPages.push_back(std::make_unique<ProcessPages>());
         }
+        pages = processPages[handle].get();
+        handleByPid[pid] = handle;
+        owner = nextOwner++;
     }
-    
-    for (uint32_t i = initialPages; i < pagesNeeded; ++i) {
-        std::vector<uint8_t> dummyData(frameSize, 0xAA + (i % 10)); 
-        BackingStore::pageOut(pid, i, dummyData);
-        totalPagesPagedOut.fetch_add(1);
-        //std::cout << "[DEBUG] Writing page " << i << " of process " << pid << " to backing store" << std::endl;
+
+    {
+        std::lock_guard<std::mutex> lock(pages->mtx);
+        pages->pid = pid;
+        pages->owner = owner;
+        pages->frames.assign(pagesNeeded, -1);
+        pages->size = memoryRequired;
+        pages->residentPages = 0;
+        pages->inUse = true;
+        pages->lastPage = 0;
+        pages->lastStride = 0;
+        pages->strideRepeated = false;
+
+        if (firstFrame >= 0) {
+            std::fill_n(frameStorage.begin() + static_cast<size_t>(firstFrame) * frameSize, frameSize, 0);
+            frameDirty[firstFrame].store(false, std::memory_order_relaxed);
+            mapPageUnlocked(handle, *pages, 0, firstFrame);
+        }
     }
+
+    // The remaining pages are zero-filled on their first fault; they reach the store only once evicted.
     
+    process->getWorkingSet().reset(workingSetWindow, pagesNeeded);
+    process->setMemoryHandle(handle);
     process->setMemory(memoryRequired, pagesNeeded);
     return reinterpret_cast<void*>(1); 
 }
 
 void DemandPagingAllocator::deallocate(std::shared_ptr<Process> process) {
-    std::string pid = process->getPid();
-    if (pageTables.count(pid)) {
-        
-        for (auto& entry : pageTables[pid]) {
-            int frameIndex = entry.second;
-            freeFrames.insert(frameIndex);
-            frameTable[frameIndex] = PageInfo{"", -1};
+    int handle = process->getMemoryHandle();
+    ProcessPages* pages = findProcess(handle);
+    if (!pages) {
+        return;
+    }
+
+    std::string pid;
+    std::vector<int> released;
+    {
+        std::lock_guard<std::mutex> lock(pages->mtx);
+        if (!pages->inUse) {
+            return;
         }
-        pageTables.erase(pid);
-        fifoQueue.remove_if([&](const PageInfo& p) { return p.pid == pid; });
-        lruTimestamps.erase(pid);
-        
-        uint32_t memoryRequired = process->getMemoryRequired();
-        process->setMemory(memoryRequired, 0);
+
+        // No core may keep using the frames, or the handle once it is reused.
+        shootdownProcess(handle);
+
+        std::lock_guard<std::mutex> policyLock(policyMtx);
+        for (size_t page = 0; page < pages->frames.size(); ++page) {
+            int frameIndex = pages->frames[page];
+            if (frameIndex < 0) continue;
+            // A frame already claimed by an evictor is that thread's to reuse.
+            if (frameTable[frameIndex].handle != handle) continue;
+            if (replacementPolicy) replacementPolicy->onRelease(frameIndex);
+            frameTable[frameIndex] = FrameEntry{-1, -1};
+            released.push_back(frameIndex);
+        }
+
+        pid = pages->pid;
+        pages->frames.clear();
+        pages->residentPages = 0;
+        pages->inUse = false;
     }
+
+    freeFrames.releaseAll(std::move(released));
+    compressedPool.release(pid);
+    writeBehind.cancel(pid);
+    BackingStore::release(pid);
+
+    {
+        std::unique_lock<std::shared_mutex> registryLock(registryMtx);
+        handleByPid.erase(pid);
+        freeHandles.push_back(handle);
+    }
+
+    process->getWorkingSet().reset(0, 0);
+    process->setMemoryHandle(-1);
+    uint32_t memoryRequired = process->getMemoryRequired();
+    process->setMemory(memoryRequired, 0);
 }
 
 void DemandPagingAllocator::visualizeMemory() const {
     std::cout << "Memory Visualization:\n";
 
     std::cout << "Free Frames: ";
-    for (const auto& frame : freeFrames) {
+    freeFrames.forEach([](int frame) {
         std::cout << frame << " ";
-    }
+    });
     std::cout << std::endl;
 
     std::cout << "Allocated Pages: \n";
-    for (const auto& process : pageTables) {
-        for (const auto& page : process.second) {
-            std::cout << "Process " << process.first << " has page " << page.first
-                      << " in frame " << page.second << std::endl;
+    std::shared_lock<std::shared_mutex> registryLock(registryMtx);
+    for (const auto& pages : processPages) {
+        std::lock_guard<std::mutex> lock(pages->mtx);
+        if (!pages->inUse) continue;
+        for (size_t page = 0; page < pages->frames.size(); ++page) {
+            if (pages->frames[page] < 0) continue;
+            std::cout << "Process " << pages->pid << " has page " << page
+                      << " in frame " << pages->frames[page] << std::endl;
         }
     }
 }
 
-bool DemandPagingAllocator::accessMemory(const std::string& pid, int pageNumber) {
-    if (pageTables[pid].count(pageNumber)) {
-        if (policy == PageReplacementPolicy::LRU) {
-            lruTimestamps[pid][pageNumber] = std::chrono::steady_clock::now().time_since_epoch().count();
+bool DemandPagingAllocator::accessMemory(int coreId, Process& process, int pageNumber) {
+    int handle = process.getMemoryHandle();
+    if (TranslationBuffer* tlb = tlbFor(coreId)) {
+        int frameIndex;
+        {
+            std::lock_guard<std::mutex> tlbLock(tlb->mtx);
+            frameIndex = tlb->lookupUnlocked(handle, pageNumber);
         }
-        return true;
+        tlb->recordLookup(frameIndex >= 0);
+        if (frameIndex >= 0) {
+            bufferHit(coreId, handle, pageNumber, frameIndex);
+            process.getWorkingSet().record(pageNumber, false);
+            return true;
+        }
+        flushHits(coreId);
     }
 
-    handlePageFault(pid, pageNumber);
-    return false;
+    ProcessPages* pages = findProcess(handle);
+    if (!pages) return true;
+
+    std::unique_lock<std::mutex> lock(pages->mtx);
+    if (!pages->inUse || pageNumber < 0 || pageNumber >= static_cast<int>(pages->frames.size())) return true;
+
+    bool faulted = false;
+    int frameIndex = residentFrame(handle, *pages, lock, pageNumber, faulted);
+    if (frameIndex >= 0) cacheTranslation(coreId, handle, pageNumber, frameIndex);
+    process.getWorkingSet().record(pageNumber, faulted);
+    return !faulted;
 }
 
-void DemandPagingAllocator::handlePageFault(const std::string& pid, int pageNumber) {
-    int frameIndex;
-    
-    if (!freeFrames.empty()) {
-        frameIndex = *freeFrames.begin();
-        freeFrames.erase(freeFrames.begin());
-    } else {
-        frameIndex = evictPage();
+void DemandPagingAllocator::setReadahead(size_t pages, bool followStride) {
+    readaheadPages = pages;
+    this->followStride = followStride;
+}
+
+void DemandPagingAllocator::setWorkingSetWindow(size_t references) {
+    workingSetWindow = references;
+}
+
+MemoryAccessResult DemandPagingAllocator::readWord(Process& process, int coreId, uint32_t address, uint16_t& value) {
+    return accessWord(process, coreId, address, &value, nullptr);
+}
+
+MemoryAccessResult DemandPagingAllocator::writeWord(Process& process, int coreId, uint32_t address, uint16_t value) {
+    return accessWord(process, coreId, address, nullptr, &value);
+}
+
+MemoryAccessResult DemandPagingAllocator::accessWord(Process& process, int coreId, uint32_t address, uint16_t* readValue, const uint16_t* writeValue) {
+    int handle = process.getMemoryHandle();
+    TranslationBuffer* tlb = tlbFor(coreId);
+    if (tlb && handle >= 0 && static_cast<uint64_t>(address) + 2 <= process.getMemoryRequired()) {
+        bool hit = accessWordCached(coreId, *tlb, handle, address, readValue, writeValue);
+        tlb->recordLookup(hit);
+        if (hit) {
+            process.getWorkingSet().record(static_cast<int>(address / frameSize), false);
+            return MemoryAccessResult::OK;
+        }
+        flushHits(coreId);
     }
 
-    readPageFromStore(pid, pageNumber);
+    ProcessPages* pages = findProcess(handle);
+    if (!pages) return MemoryAccessResult::OUT_OF_RANGE;
 
-    frameTable[frameIndex] = PageInfo{pid, pageNumber};
-    pageTables[pid][pageNumber] = frameIndex;
+    std::unique_lock<std::mutex> lock(pages->mtx);
+    if (!pages->inUse || static_cast<uint64_t>(address) + 2 > pages->size) return MemoryAccessResult::OUT_OF_RANGE;
 
-    if (policy == PageReplacementPolicy::FIFO) {
-        fifoQueue.push_back(PageInfo{pid, pageNumber});
-    } else if (policy == PageReplacementPolicy::LRU) {
-        lruTimestamps[pid][pageNumber] = std::chrono::steady_clock::now().time_since_epoch().count();
+    // The two bytes may straddle a page boundary; each is touched right after its page is made resident.
+    bool faulted = false;
+    uint16_t result = 0;
+    int frameIndex = -1;
+    int mappedPage = -1;
+    for (uint32_t i = 0; i < 2; ++i) {
+        uint32_t byteAddress = address + i;
+        int pageNumber = static_cast<int>(byteAddress / frameSize);
+        if (pageNumber != mappedPage) {
+            frameIndex = residentFrame(handle, *pages, lock, pageNumber, faulted);
+            if (frameIndex < 0) return MemoryAccessResult::OUT_OF_RANGE;
+            cacheTranslation(coreId, handle, pageNumber, frameIndex);
+            mappedPage = pageNumber;
+        }
+
+        uint8_t& byte = frameStorage[static_cast<size_t>(frameIndex) * frameSize + byteAddress % frameSize];
+        if (writeValue) {
+            byte = static_cast<uint8_t>(*writeValue >> (8 * i));
+            frameDirty[frameIndex].store(true, std::memory_order_relaxed);
+        } else {
+            result |= static_cast<uint16_t>(byte) << (8 * i);
+        }
     }
+
+    if (readValue) *readValue = result;
+    process.getWorkingSet().record(static_cast<int>(address / frameSize), faulted);
+    return faulted ? MemoryAccessResult::PAGE_FAULT : MemoryAccessResult::OK;
 }
 
-int DemandPagingAllocator::evictPage() {
-    PageInfo evicted;
-    if (policy == PageReplacementPolicy::FIFO) {
-        evicted = fifoQueue.front();
-        fifoQueue.pop_front();
-    } else if (policy == PageReplacementPolicy::LRU) {
-        long long oldestTime = LLONG_MAX;
-        for (const auto& [pid, pageMap] : lruTimestamps) {
-            for (const auto& [page, time] : pageMap) {
-                if (time < oldestTime) {
-                    oldestTime = time;
-                    evicted = {pid, page};
-                }
+bool DemandPagingAllocator::accessWordCached(int coreId, TranslationBuffer& tlb, int handle, uint32_t address, uint16_t* readValue, const uint16_t* writeValue) {
+    int frames[2];
+    int pageNumbers[2];
+    {
+        std::lock_guard<std::mutex> tlbLock(tlb.mtx);
+        for (uint32_t i = 0; i < 2; ++i) {
+            int pageNumber = static_cast<int>((address + i) / frameSize);
+            pageNumbers[i] = pageNumber;
+            frames[i] = (i == 1 && pageNumber == pageNumbers[0]) ? frames[0] : tlb.lookupUnlocked(handle, pageNumber);
+            if (frames[i] < 0) return false;
+        }
+
+        // Holding the TLB lock keeps a shootdown, and so the write-back of these frames, waiting.
+        uint16_t result = 0;
+        for (uint32_t i = 0; i < 2; ++i) {
+            uint8_t& byte = frameStorage[static_cast<size_t>(frames[i]) * frameSize + (address + i) % frameSize];
+            if (writeValue) {
+                byte = static_cast<uint8_t>(*writeValue >> (8 * i));
+                frameDirty[frames[i]].store(true, std::memory_order_relaxed);
+            } else {
+                result |= static_cast<uint16_t>(byte) << (8 * i);
             }
         }
-        lruTimestamps[evicted.pid].erase(evicted.pageNumber);
-    } else {
+        if (readValue) *readValue = result;
+    }
+
+    bufferHit(coreId, handle, pageNumbers[0], frames[0]);
+    if (frames[1] != frames[0]) bufferHit(coreId, handle, pageNumbers[1], frames[1]);
+    return true;
+}
+
+void DemandPagingAllocator::recordHit(int handle, int frameIndex) {
+    if (!replacementPolicy) return;
+    replacementPolicy->recordAccess(true);
+    if (!replacementPolicy->tracksHits()) return;
+    std::lock_guard<std::mutex> policyLock(policyMtx);
+    // An evictor may already have claimed the frame; it is no longer the policy's to track.
+    if (frameTable[frameIndex].handle == handle) replacementPolicy->onHit(frameIndex);
+}
+
+void DemandPagingAllocator::bufferHit(int coreId, int handle, int pageNumber, int frameIndex) {
+    if (!replacementPolicy) return;
+    replacementPolicy->recordAccess(true);
+    if (!replacementPolicy->tracksHits()) return;
+    std::vector<PendingHit>& hits = hitBuffers[coreId]->hits;
+    hits.push_back(PendingHit{handle, pageNumber, frameIndex});
+    if (hits.size() >= HIT_BATCH_SIZE) flushHits(coreId);
+}
+
+void DemandPagingAllocator::flushHits(int coreId) {
+    std::vector<PendingHit>& hits = hitBuffers[coreId]->hits;
+    if (hits.empty()) return;
+    std::lock_guard<std::mutex> policyLock(policyMtx);
+    for (const PendingHit& hit : hits) {
+        // The page may have been evicted, and its frame reused, since the hit.
+        const FrameEntry& entry = frameTable[hit.frameIndex];
+        if (entry.handle == hit.handle && entry.pageNumber == hit.pageNumber) replacementPolicy->onHit(hit.frameIndex);
+    }
+    hits.clear();
+}
+
+int DemandPagingAllocator::residentFrame(int handle, ProcessPages& pages, std::unique_lock<std::mutex>& lock, int pageNumber, bool& faulted) {
+    trackStrideUnlocked(pages, pageNumber);
+    int frameIndex = pages.frames[pageNumber];
+    if (frameIndex >= 0) {
+        recordHit(handle, frameIndex);
+        return frameIndex;
+    }
+
+    faulted = true;
+    totalPageFaults.fetch_add(1);
+    if (replacementPolicy) replacementPolicy->recordAccess(false);
+
+    // Evicting may need the victim's lock, which could be our own, so find the frame unlocked.
+    uint64_t owner = pages.owner;
+    lock.unlock();
+    frameIndex = obtainFrame(owner, pageNumber);
+    lock.lock();
+
+    // The process may have been deallocated (and its handle reused) or the page mapped meanwhile.
+    if (!pages.inUse || pages.owner != owner) {
+        freeFrames.release(frameIndex);
+        return -1;
+    }
+    if (pages.frames[pageNumber] >= 0) {
+        freeFrames.release(frameIndex);
+        return pages.frames[pageNumber];
+    }
+
+    readPageFromStore(pages, pageNumber, frameIndex);
+    mapPageUnlocked(handle, pages, pageNumber, frameIndex);
+    prefetchUnlocked(handle, pages, pageNumber);
+    return frameIndex;
+}
+
+void DemandPagingAllocator::trackStrideUnlocked(ProcessPages& pages, int pageNumber) {
+    if (pageNumber == pages.lastPage) return;
+    int stride = pageNumber - pages.lastPage;
+    pages.strideRepeated = (stride == pages.lastStride);
+    pages.lastStride = stride;
+    pages.lastPage = pageNumber;
+}
+
+void DemandPagingAllocator::prefetchUnlocked(int handle, ProcessPages& pages, int pageNumber) {
+    int step = (followStride && pages.strideRepeated) ? pages.lastStride : 1;
+    for (size_t ahead = 1; ahead <= readaheadPages; ++ahead) {
+        long long target = pageNumber + static_cast<long long>(step) * static_cast<long long>(ahead);
+        if (target < 0 || target >= static_cast<long long>(pages.frames.size())) break;
+        if (pages.frames[target] >= 0) continue;
+
+        // The last free frame is left for admitting a waiting process, which can not evict.
+        if (freeFrames.size() <= 1) break;
+        int frameIndex = freeFrames.takeFirst();
+        if (frameIndex < 0) break;
+        readPageFromStore(pages, static_cast<int>(target), frameIndex);
+        mapPageUnlocked(handle, pages, static_cast<int>(target), frameIndex);
+        pagesPrefetched.fetch_add(1);
+    }
+}
+
+void DemandPagingAllocator::mapPageUnlocked(int handle, ProcessPages& pages, int pageNumber, int frameIndex) {
+    pages.frames[pageNumber] = frameIndex;
+    ++pages.residentPages;
+    std::lock_guard<std::mutex> policyLock(policyMtx);
+    frameTable[frameIndex] = FrameEntry{handle, pageNumber};
+    if (replacementPolicy) replacementPolicy->onPageIn(frameIndex, PageKey{pages.owner, pageNumber});
+}
+
+int DemandPagingAllocator::obtainFrame(uint64_t owner, int pageNumber) {
+    while (true) {
+        int frameIndex = freeFrames.takeFirst();
+        if (frameIndex >= 0) return frameIndex;
+
+        frameIndex = evictPage(owner, pageNumber);
+        if (frameIndex >= 0) return frameIndex;
+
+        // Every frame is in flight on another core; one of them will free up shortly.
+        std::this_thread::yield();
+    }
+}
+
+int DemandPagingAllocator::evictPage(uint64_t owner, int pageNumber) {
+    if (!replacementPolicy) {
         std::cerr << "No page replacement policy set. Cannot evict." << std::endl;
         std::exit(1);
     }
 
-    int frameIndex = pageTables[evicted.pid][evicted.pageNumber];
+    auto started = std::chrono::steady_clock::now();
+    int frameIndex;
+    FrameEntry evicted;
+    {
+        std::lock_guard<std::mutex> policyLock(policyMtx);
+        frameIndex = replacementPolicy->selectVictim(PageKey{owner, pageNumber});
+        if (frameIndex < 0) return -1;
+        evicted = frameTable[frameIndex];
+        frameTable[frameIndex] = FrameEntry{-1, -1};
+    }
 
-    writePageToStore(evicted.pid, evicted.pageNumber);
+    totalEvictionNanos.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - started).count());
+    totalEvictions.fetch_add(1);
 
-    pageTables[evicted.pid].erase(evicted.pageNumber);
-    frameTable[frameIndex] = PageInfo{"", -1};
+    ProcessPages* victim = findProcess(evicted.handle);
+    if (victim) {
+        std::lock_guard<std::mutex> lock(victim->mtx);
+        // Skip the write-back if the victim was deallocated while we chose it.
+        if (victim->inUse && evicted.pageNumber < static_cast<int>(victim->frames.size())
+            && victim->frames[evicted.pageNumber] == frameIndex) {
+            shootdownPage(evicted.handle, evicted.pageNumber);
+            if (frameDirty[frameIndex].exchange(false, std::memory_order_relaxed)) {
+                writePageToStore(*victim, evicted.pageNumber, frameIndex);
+            } else {
+                cleanEvictions.fetch_add(1);
+            }
+            victim->frames[evicted.pageNumber] = -1;
+            --victim->residentPages;
+        }
+    }
 
     return frameIndex;
 }
 
-
-void DemandPagingAllocator::writePageToStore(const std::string& pid, int pageNumber) {
-    std::vector<uint8_t> dummyData(frameSize, 0xFF);
-    BackingStore::pageOut(pid, pageNumber, dummyData);
+void DemandPagingAllocator::writePageToStore(const ProcessPages& pages, int pageNumber, int frameIndex) {
+    auto frameBegin = frameStorage.begin() + static_cast<size_t>(frameIndex) * frameSize;
+    std::vector<uint8_t> data(frameBegin, frameBegin + frameSize);
+    if (compressedPool.enabled()) {
+        compressedPool.store(pages.pid, pageNumber, data);
+    } else {
+        writeBehind.enqueue(pages.pid, pageNumber, std::move(data));
+    }
     totalPagesPagedOut.fetch_add(1);
 }
 
-void DemandPagingAllocator::readPageFromStore(const std::string& pid, int pageNumber) {
-    std::vector<uint8_t> data = BackingStore::pageIn(pid, pageNumber);
+void DemandPagingAllocator::readPageFromStore(const ProcessPages& pages, int pageNumber, int frameIndex) {
+    auto frameBegin = frameStorage.begin() + static_cast<size_t>(frameIndex) * frameSize;
+    std::vector<uint8_t> data;
+    // The pool gives its copy up, so a page loaded from it has to be written again on eviction.
+    bool pooled = compressedPool.load(pages.pid, pageNumber, data);
+    if (!pooled) {
+        if (!writeBehind.readPending(pages.pid, pageNumber, data)) {
+            data = BackingStore::pageIn(pages.pid, pageNumber);
+        }
+        if (!data.empty()) storeReads.fetch_add(1);
+    }
+    // A page that was never written out has no slot yet and starts out zeroed.
+    std::fill_n(frameBegin, frameSize, 0);
+    std::copy_n(data.begin(), std::min(data.size(), frameSize), frameBegin);
+    frameDirty[frameIndex].store(pooled, std::memory_order_relaxed);
     totalPagesPagedIn.fetch_add(1);
 }
 
-int DemandPagingAllocator::getPagesInPhysicalMemory(const std::string& pid) const {
-    int count = 0;
-    auto it = pageTables.find(pid);
-    if (it != pageTables.end()) {
-        for (const auto& pageEntry : it->second) {
-            if (pageEntry.second >= 0) {
-                count++;
-            }
-        }
+TranslationBuffer* DemandPagingAllocator::tlbFor(int coreId) const {
+    return coreId >= 0 && coreId < static_cast<int>(tlbs.size()) ? tlbs[coreId].get() : nullptr;
+}
+
+void DemandPagingAllocator::cacheTranslation(int coreId, int handle, int pageNumber, int frameIndex) {
+    // Runs under the owner's process lock, so an eviction of the page can not have started yet.
+    if (TranslationBuffer* tlb = tlbFor(coreId)) {
+        std::lock_guard<std::mutex> tlbLock(tlb->mtx);
+        tlb->insertUnlocked(handle, pageNumber, frameIndex);
     }
-    return count;
 }
 
-int DemandPagingAllocator::getPagesInBackingStore(const std::string& pid) const {
-    auto it = pageTables.find(pid);
-    if (it != pageTables.end()) {
-        int totalPages = it->second.size();
-        int pagesInMemory = getPagesInPhysicalMemory(pid);
-        return totalPages - pagesInMemory;
+void DemandPagingAllocator::shootdownPage(int handle, int pageNumber) {
+    for (const auto& tlb : tlbs) {
+        tlb->invalidatePage(handle, pageNumber);
+    }
+}
+
+void DemandPagingAllocator::shootdownProcess(int handle) {
+    for (const auto& tlb : tlbs) {
+        tlb->invalidateProcess(handle);
     }
-    return 0;
+}
+
+DemandPagingAllocator::ProcessPages* DemandPagingAllocator::findProcess(int handle) const {
+    std::shared_lock<std::shared_mutex> registryLock(registryMtx);
+    if (handle < 0 || handle >= static_cast<int>(processPages.size())) return nullptr;
+    return processPages[handle].get();
+}
+
+DemandPagingAllocator::ProcessPages* DemandPagingAllocator::findProcess(const std::string& pid) const {
+    std::shared_lock<std::shared_mutex> registryLock(registryMtx);
+    auto it = handleByPid.find(pid);
+    return it != handleByPid.end() ? processPages[it->second].get() : nullptr;
+}
+
+int DemandPagingAllocator::getPagesInPhysicalMemory(const std::string& pid) const {
+    ProcessPages* pages = findProcess(pid);
+    if (!pages) return 0;
+    std::lock_guard<std::mutex> lock(pages->mtx);
+    return pages->inUse ? pages->residentPages : 0;
+}
+
+int DemandPagingAllocator::getResidentPages(int handle) const {
+    ProcessPages* pages = findProcess(handle);
+    if (!pages) return 0;
+    std::lock_guard<std::mutex> lock(pages->mtx);
+    return pages->inUse ? pages->residentPages : 0;
+}
+
+int DemandPagingAllocator::getPagesInBackingStore(const std::string& pid) const {
+    ProcessPages* pages = findProcess(pid);
+    if (!pages) return 0;
+    std::lock_guard<std::mutex> lock(pages->mtx);
+    return pages->inUse ? static_cast<int>(pages->frames.size()) - pages->residentPages : 0;
 }
 
 long long DemandPagingAllocator::getTotalPagesPagedIn() const {
@@ -202,3 +572,54 @@ long long DemandPagingAllocator::getTotalPagesPagedIn() const {
 long long DemandPagingAllocator::getTotalPagesPagedOut() const {
     return totalPagesPagedOut.load();
 }
+
+long long DemandPagingAllocator::getTotalEvictions() const {
+    return totalEvictions.load();
+}
+
+double DemandPagingAllocator::getCompressedPoolHitRate() const {
+    long long hits = compressedPool.getHits();
+    long long total = hits + storeReads.load();
+    return total > 0 ? static_cast<double>(hits) / total : 0.0;
+}
+
+long long DemandPagingAllocator::getTotalPageFaults() const {
+    return totalPageFaults.load();
+}
+
+long long DemandPagingAllocator::getPagesPrefetched() const {
+    return pagesPrefetched.load();
+}
+
+long long DemandPagingAllocator::getCleanEvictions() const {
+    return cleanEvictions.load();
+}
+
+size_t DemandPagingAllocator::getPendingPageOuts() const {
+    return writeBehind.getPendingCount();
+}
+
+long long DemandPagingAllocator::getPageOutStalls() const {
+    return writeBehind.getStallCount();
+}
+
+double DemandPagingAllocator::getAverageEvictionLatencyNanos() const {
+    long long evictions = totalEvictions.load();
+    return evictions > 0 ? static_cast<double>(totalEvictionNanos.load()) / evictions : 0.0;
+}
+
+const char* DemandPagingAllocator::getPolicyName() const {
+    return replacementPolicy ? replacementPolicy->getName() : "NONE";
+}
+
+double DemandPagingAllocator::getPolicyHitRatio() const {
+    return replacementPolicy ? replacementPolicy->getHitRatio() : 0.0;
+}
+
+long long DemandPagingAllocator::getTotalTlbShootdowns() const {
+    long long total = 0;
+    for (const auto& tlb : tlbs) {
+        total += tlb->getShootdowns();
+    }
+    return total;
+}
\ No newline at end of file
@@ -1,63 +1,194 @@
 #pragma once
 
 #include "memory/IMemoryAllocator.h"
+#include "memory/IPageReplacementPolicy.h"
+#include "memory/FrameBitmap.h"
+#include "memory/TranslationBuffer.h"
+#include "memory/WriteBehindQueue.h"
+#include "memory/CompressedPagePool.h"
 #include "core/Process.h"
 
 #include <unordered_map>
-#include <list>
-#include <set>
 #include <string>
 #include <vector>
 #include <atomic>
+#include <mutex>
+#include <shared_mutex>
 
 class DemandPagingAllocator : public IMemoryAllocator {
 public:
     enum class PageReplacementPolicy {
         NONE,
         FIFO,
-        LRU
+        LRU,
+        CLOCK,
+        LFU,
+        ARC,
+        TWO_Q
     };
 
-    DemandPagingAllocator(size_t totalMemorySize, size_t frameSize, PageReplacementPolicy policy);
+    // Each of coreCount cores gets a tlbEntries-entry, tlbWays-way TLB; tlbEntries 0 disables them.
+    // Evicted pages are kept compressed in up to compressedPoolBytes before reaching the file.
+    DemandPagingAllocator(size_t totalMemorySize, size_t frameSize, PageReplacementPolicy policy,
+                          size_t coreCount = 1, size_t tlbEntries = 0, size_t tlbWays = 1,
+                          size_t compressedPoolBytes = 0);
 
     void* allocate(std::shared_ptr<Process> process) override;
     void deallocate(std::shared_ptr<Process> process) override;
     void visualizeMemory() const override;
-    bool accessMemory(const std::string& pid, int pageNumber);
+    MemoryAccessResult readWord(Process& process, int coreId, uint32_t address, uint16_t& value) override;
+    MemoryAccessResult writeWord(Process& process, int coreId, uint32_t address, uint16_t value) override;
+    // A TLB hit skips the page table entirely.
+    bool accessMemory(int coreId, Process& process, int pageNumber);
+
+    // A fault also fills up to `pages` following pages into free frames (all but the last), never evicting for them.
+    // With followStride they follow the process's last repeated page stride instead of +1.
+    void setReadahead(size_t pages, bool followStride);
+    // Each process's working set is estimated over its last `references` page references; 0 disables it.
+    void setWorkingSetWindow(size_t references);
 
     int getPagesInPhysicalMemory(const std::string& pid) const;
+    // Same count by handle, skipping the lookup by pid.
+    int getResidentPages(int handle) const;
     int getPagesInBackingStore(const std::string& pid) const;
     
     long long getTotalPagesPagedIn() const;
     long long getTotalPagesPagedOut() const;
+    long long getTotalEvictions() const;
+    long long getTotalPageFaults() const;
+    long long getPagesPrefetched() const;
+    // Evictions of pages unchanged since they were last read in, which need no page-out.
+    long long getCleanEvictions() const;
+    size_t getPendingPageOuts() const;
+    // Times an evictor had to wait for room in the write-behind queue.
+    long long getPageOutStalls() const;
+
+    const CompressedPagePool& getCompressedPool() const { return compressedPool; }
+    // Share of page-ins of previously written pages that the compressed pool served.
+    double getCompressedPoolHitRate() const;
+    // Mean time spent choosing and unlinking a victim, excluding the page-out itself.
+    double getAverageEvictionLatencyNanos() const;
+
+    const char* getPolicyName() const;
+    double getPolicyHitRatio() const;
+
+    // Per-core TLB counters; getTlbCount() is 0 when TLBs are disabled.
+    size_t getTlbCount() const { return tlbs.size(); }
+    size_t getTlbEntries() const { return tlbEntries; }
+    size_t getTlbWays() const { return tlbWays; }
+    long long getTlbHits(int coreId) const { return tlbs[coreId]->getHits(); }
+    long long getTlbMisses(int coreId) const { return tlbs[coreId]->getMisses(); }
+    long long getTotalTlbShootdowns() const;
 
 private:
     size_t frameSize;
     size_t totalFrames;
     PageReplacementPolicy policy;
+    std::unique_ptr<IPageReplacementPolicy> replacementPolicy;
 
-    struct PageInfo {
-        std::string pid;
+    // Owner of each frame; handle is -1 while the frame is free or being evicted.
+    struct FrameEntry {
+        int handle;
         int pageNumber;
     };
 
+    // Dense page table of one process, indexed by page number; -1 means not resident.
+    // Entries are pooled and never destroyed, so a pointer stays valid after the handle is freed.
+    struct ProcessPages {
+        std::mutex mtx;
+        std::string pid;
+        uint64_t owner = 0;
+        std::vector<int> frames;
+        uint32_t size = 0;
+        int residentPages = 0;
+        bool inUse = false;
+        // Stride detector over page-table lookups; strideRepeated once two moves in a row matched.
+        int lastPage = 0;
+        int lastStride = 0;
+        bool strideRepeated = false;
+    };
 
-    std::vector<PageInfo> frameTable;
-    std::set<int> freeFrames;
-
-    std::unordered_map<std::string, std::unordered_map<int, int>> pageTables;
-
-    std::list<PageInfo> fifoQueue;
+    // Locking: registryMtx guards the handle table and is never held while taking another lock.
+    // A ProcessPages::mtx guards that process's page table, and policyMtx guards the replacement
+    // policy and frameTable; a thread may take policyMtx while holding one process lock, never
+    // the other way round, and never holds two process locks. Free frames need no lock.
+    // A core's TLB lock may be taken while holding a process lock but not policyMtx, and a
+    // process lock is never taken while holding a TLB lock.
+    std::vector<FrameEntry> frameTable;
+    // Contents of every frame, frameSize bytes each; a frame's bytes belong to its owner's process lock.
+    std::vector<uint8_t> frameStorage;
+    // Set by writes; a frame is clean while it matches what its page would read back from the store.
+    std::vector<std::atomic<bool>> frameDirty;
+    FrameBitmap freeFrames;
+    mutable std::mutex policyMtx;
+
+    std::vector<std::unique_ptr<ProcessPages>> processPages;
+    std::vector<int> freeHandles;
+    std::unordered_map<std::string, int> handleByPid;
+    uint64_t nextOwner;
+    mutable std::shared_mutex registryMtx;
+
+    size_t tlbEntries;
+    size_t tlbWays;
+    std::vector<std::unique_ptr<TranslationBuffer>> tlbs;
+
+    // TLB hits waiting to reach the replacement policy, one buffer per core and only touched by
+    // the thread running that core. They are applied in one policyMtx acquisition when the buffer
+    // fills or the core next misses its TLB, so a hit costs no shared lock.
+    struct PendingHit {
+        int handle;
+        int pageNumber;
+        int frameIndex;
+    };
+    struct HitBuffer {
+        std::vector<PendingHit> hits;
+    };
+    std::vector<std::unique_ptr<HitBuffer>> hitBuffers;
 
-    std::unordered_map<std::string, std::unordered_map<int, long long>> lruTimestamps;
+    size_t readaheadPages;
+    bool followStride;
+    size_t workingSetWindow;
 
     mutable std::atomic<long long> totalPagesPagedIn;
     mutable std::atomic<long long> totalPagesPagedOut;
-
-    void handlePageFault(const std::string& pid, int pageNumber);
-
-    int evictPage();
-
-    void writePageToStore(const std::string& pid, int pageNumber);
-    void readPageFromStore(const std::string& pid, int pageNumber);
+    std::atomic<long long> totalEvictions;
+    std::atomic<long long> totalEvictionNanos;
+    std::atomic<long long> cleanEvictions;
+    std::atomic<long long> totalPageFaults;
+    std::atomic<long long> pagesPrefetched;
+    // Page-ins served by the write-behind queue or the file rather than the compressed pool.
+    std::atomic<long long> storeReads;
+
+    WriteBehindQueue writeBehind;
+    CompressedPagePool compressedPool;
+
+    ProcessPages* findProcess(int handle) const;
+    ProcessPages* findProcess(const std::string& pid) const;
+
+    // Returns the frame holding pageNumber, faulting it in first if needed; -1 if the process
+    // went away meanwhile. lock holds pages.mtx on entry and exit but is released while evicting.
+    int residentFrame(int handle, ProcessPages& pages, std::unique_lock<std::mutex>& lock, int pageNumber, bool& faulted);
+    MemoryAccessResult accessWord(Process& process, int coreId, uint32_t address, uint16_t* readValue, const uint16_t* writeValue);
+    // Completes the access from the TLB alone; false (with nothing touched) if a page is not cached.
+    bool accessWordCached(int coreId, TranslationBuffer& tlb, int handle, uint32_t address, uint16_t* readValue, const uint16_t* writeValue);
+    void recordHit(int handle, int frameIndex);
+    void bufferHit(int coreId, int handle, int pageNumber, int frameIndex);
+    void flushHits(int coreId);
+
+    TranslationBuffer* tlbFor(int coreId) const;
+    void cacheTranslation(int coreId, int handle, int pageNumber, int frameIndex);
+    // Removes the translation from every core's TLB and waits for accesses through it to finish.
+    void shootdownPage(int handle, int pageNumber);
+    void shootdownProcess(int handle);
+
+    void trackStrideUnlocked(ProcessPages& pages, int pageNumber);
+    // Reads ahead of a fault on pageNumber while pages.mtx is still held.
+    void prefetchUnlocked(int handle, ProcessPages& pages, int pageNumber);
+    void mapPageUnlocked(int handle, ProcessPages& pages, int pageNumber, int frameIndex);
+
+    int obtainFrame(uint64_t owner, int pageNumber);
+    int evictPage(uint64_t owner, int pageNumber);
+
+    void writePageToStore(const ProcessPages& pages, int pageNumber, int frameIndex);
+    void readPageFromStore(const ProcessPages& pages, int pageNumber, int frameIndex);
 };
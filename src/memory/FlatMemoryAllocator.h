@@ -40,6 +40,27 @@ public:
         }
     }
 
+    MemoryAccessResult readWord(Process& process, int, uint32_t address, uint16_t& value) override {
+        auto it = allocations.find(process.getProcessName());
+        if (it == allocations.end() || static_cast<size_t>(address) + 2 > it->second.second) {
+            return MemoryAccessResult::OUT_OF_RANGE;
+        }
+        size_t base = it->second.first + address;
+        value = static_cast<uint16_t>(static_cast<uint8_t>(memory[base]) | (static_cast<uint8_t>(memory[base + 1]) << 8));
+        return MemoryAccessResult::OK;
+    }
+
+    MemoryAccessResult writeWord(Process& process, int, uint32_t address, uint16_t value) override {
+        auto it = allocations.find(process.getProcessName());
+        if (it == allocations.end() || static_cast<size_t>(address) + 2 > it->second.second) {
+            return MemoryAccessResult::OUT_OF_RANGE;
+        }
+        size_t base = it->second.first + address;
+        memory[base] = static_cast<char>(value & 0xFF);
+        memory[base + 1] = static_cast<char>(value >> 8);
+        return MemoryAccessResult::OK;
+    }
+
     void visualizeMemory() const override {
         for (size_t i = 0; i < memory.size(); ++i) {
             std::cout << memory[i];
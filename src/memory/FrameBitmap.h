@@ -0,0 +1,136 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+// Lock-free free-frame set as a two-level bitmap: one bit per frame (1 = free) in 64-bit words,
+// plus a summary bit per word that is set while the word may have a free frame. Taking a frame
+// is two find-first-set steps and a CAS on the word; summaryHint skips summary words known to be empty.
+// Any thread may take or release concurrently.
+class FrameBitmap {
+public:
+    explicit FrameBitmap(size_t frameCount)
+        : words((frameCount + 63) / 64),
+          summary((words.size() + 63) / 64),
+          freeCount(0),
+          summaryHint(0) {
+        releaseRange(0, frameCount);
+    }
+
+    FrameBitmap(const FrameBitmap&) = delete;
+    FrameBitmap& operator=(const FrameBitmap&) = delete;
+
+    // Both are snapshots while other threads are taking or releasing frames.
+    size_t size() const { return freeCount.load(std::memory_order_relaxed); }
+    bool empty() const { return size() == 0; }
+
+    bool test(int frame) const {
+        return (words[frame >> 6].load(std::memory_order_acquire) >> (frame & 63)) & 1;
+    }
+
+    // Removes and returns the lowest free frame it can claim, or -1 if none is free.
+    int takeFirst() {
+        size_t start = summaryHint.load(std::memory_order_relaxed);
+        int frame = takeFrom(start);
+        if (frame < 0 && start > 0) {
+            // A concurrent release may have landed below a hint that was raised at the same time.
+            frame = takeFrom(0);
+        }
+        return frame;
+    }
+
+    void release(int frame) {
+        applyFreeMask(frame >> 6, 1ull << (frame & 63));
+    }
+
+    // Frees a batch, e.g. every frame of a terminating process, touching each word once.
+    void releaseAll(std::vector<int> frames) {
+        std::sort(frames.begin(), frames.end());
+        size_t i = 0;
+        while (i < frames.size()) {
+            size_t w = frames[i] >> 6;
+            uint64_t mask = 0;
+            for (; i < frames.size() && static_cast<size_t>(frames[i] >> 6) == w; ++i) {
+                mask |= 1ull << (frames[i] & 63);
+            }
+            applyFreeMask(w, mask);
+        }
+    }
+
+    // Frees [begin, end), whole words at a time in the middle.
+    void releaseRange(size_t begin, size_t end) {
+        while (begin < end) {
+            size_t w = begin >> 6;
+            size_t bitStart = begin & 63;
+            size_t bitEnd = std::min<size_t>(64, bitStart + (end - begin));
+            uint64_t mask = bitEnd - bitStart == 64 ? ~0ull : ((1ull << (bitEnd - bitStart)) - 1) << bitStart;
+            applyFreeMask(w, mask);
+            begin += bitEnd - bitStart;
+        }
+    }
+
+    // Calls visit(frame) for every free frame in ascending order.
+    template <typename Visitor>
+    void forEach(Visitor&& visit) const {
+        for (size_t w = 0; w < words.size(); ++w) {
+            uint64_t bits = words[w].load(std::memory_order_acquire);
+            while (bits) {
+                visit(static_cast<int>(w * 64 + std::countr_zero(bits)));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+private:
+    int takeFrom(size_t start) {
+        for (size_t s = start; s < summary.size(); ++s) {
+            uint64_t summaryBits = summary[s].load(std::memory_order_acquire);
+            while (summaryBits) {
+                size_t w = s * 64 + std::countr_zero(summaryBits);
+                uint64_t bits = words[w].load(std::memory_order_acquire);
+                while (bits) {
+                    uint64_t lowest = bits & (~bits + 1);
+                    if (words[w].compare_exchange_weak(bits, bits & ~lowest, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                        if ((bits & ~lowest) == 0) clearSummaryBit(w);
+                        freeCount.fetch_sub(1, std::memory_order_relaxed);
+                        if (s != start) summaryHint.compare_exchange_strong(start, s, std::memory_order_relaxed);
+                        return static_cast<int>(w * 64 + std::countr_zero(lowest));
+                    }
+                }
+                clearSummaryBit(w);
+                summaryBits &= summaryBits - 1;
+            }
+        }
+        return -1;
+    }
+
+    void clearSummaryBit(size_t w) {
+        uint64_t bit = 1ull << (w & 63);
+        summary[w >> 6].fetch_and(~bit, std::memory_order_acq_rel);
+        // A release may have refilled the word between our check and the clear; put the bit back.
+        if (words[w].load(std::memory_order_acquire) != 0) {
+            summary[w >> 6].fetch_or(bit, std::memory_order_acq_rel);
+        }
+    }
+
+    void applyFreeMask(size_t w, uint64_t mask) {
+        uint64_t added = mask & ~words[w].fetch_or(mask, std::memory_order_acq_rel);
+        if (!added) return;
+        freeCount.fetch_add(std::popcount(added), std::memory_order_relaxed);
+        summary[w >> 6].fetch_or(1ull << (w & 63), std::memory_order_acq_rel);
+
+        size_t s = w >> 6;
+        size_t hint = summaryHint.load(std::memory_order_relaxed);
+        while (s < hint && !summaryHint.compare_exchange_weak(hint, s, std::memory_order_relaxed)) {}
+    }
+
+    std::vector<std::atomic<uint64_t>> words;
+    std::vector<std::atomic<uint64_t>> summary;
+    std::atomic<size_t> freeCount;
+    // No summary word below this index had a set bit when it was last moved; only a hint.
+    std::atomic<size_t> summaryHint;
+};
@@ -3,6 +3,18 @@
 #include <memory>
 #include "core/Process.h"
 
+enum class MemoryAccessResult {
+    OK,
+    PAGE_FAULT,     // the access completed after bringing its page in
+    OUT_OF_RANGE
+};
+
+enum class MemoryAllocatorType {
+    paging,
+    buddy,
+    segregated
+};
+
 class IMemoryAllocator {
 public:
     virtual ~IMemoryAllocator() = default;
@@ -10,5 +22,9 @@ public:
     virtual void* allocate(std::shared_ptr<Process> process) = 0;
     virtual void deallocate(std::shared_ptr<Process> process) = 0;
 
+    // 16-bit little-endian accesses at a process-relative address, made from coreId.
+    virtual MemoryAccessResult readWord(Process& process, int coreId, uint32_t address, uint16_t& value) = 0;
+    virtual MemoryAccessResult writeWord(Process& process, int coreId, uint32_t address, uint16_t value) = 0;
+
     virtual void visualizeMemory() const = 0;
 };
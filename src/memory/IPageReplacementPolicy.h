@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+// Identifies a page across evictions. owner is never reused, unlike the allocator's
+// process handles, so a ghost entry can not be mistaken for another process's page.
+struct PageKey {
+    uint64_t owner;
+    int pageNumber;
+
+    bool operator==(const PageKey& other) const {
+        return owner == other.owner && pageNumber == other.pageNumber;
+    }
+};
+
+struct PageKeyHash {
+    size_t operator()(const PageKey& key) const {
+        return std::hash<uint64_t>()(key.owner * 0x9E3779B97F4A7C15ull ^ static_cast<uint32_t>(key.pageNumber));
+    }
+};
+
+// Decides which resident frame DemandPagingAllocator gives up on a fault. Policies only
+// see frame indices and page identities; the allocator owns the page tables and the I/O.
+class IPageReplacementPolicy {
+public:
+    virtual ~IPageReplacementPolicy() = default;
+
+    virtual const char* getName() const = 0;
+
+    // The page now lives in frameIndex, which was free or was just returned by selectVictim.
+    virtual void onPageIn(int frameIndex, const PageKey& page) = 0;
+    virtual void onHit(int frameIndex) = 0;
+    // False when onHit does nothing, so the allocator can skip reporting hits altogether.
+    virtual bool tracksHits() const { return true; }
+    // The frame was freed without an eviction, e.g. its process was deallocated.
+    virtual void onRelease(int frameIndex) = 0;
+    // Picks a resident frame to make room for incoming and stops tracking it; -1 if none is resident.
+    virtual int selectVictim(const PageKey& incoming) = 0;
+
+    void recordAccess(bool hit) {
+        (hit ? hits : misses).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    long long getHits() const { return hits.load(std::memory_order_relaxed); }
+    long long getMisses() const { return misses.load(std::memory_order_relaxed); }
+
+    double getHitRatio() const {
+        long long h = getHits();
+        long long total = h + getMisses();
+        return total > 0 ? static_cast<double>(h) / total : 0.0;
+    }
+
+private:
+    std::atomic<long long> hits{0};
+    std::atomic<long long> misses{0};
+};
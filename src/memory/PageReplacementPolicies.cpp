@@ -0,0 +1,185 @@
+#include "memory/PageReplacementPolicies.h"
+
+#include <algorithm>
+
+void FifoReplacementPolicy::onPageIn(int frameIndex, const PageKey&) {
+    queue.pushBack(frameIndex);
+}
+
+void FifoReplacementPolicy::onHit(int) {
+}
+
+void FifoReplacementPolicy::onRelease(int frameIndex) {
+    if (queue.contains(frameIndex)) queue.remove(frameIndex);
+}
+
+int FifoReplacementPolicy::selectVictim(const PageKey&) {
+    return queue.popFront();
+}
+
+void LruReplacementPolicy::onPageIn(int frameIndex, const PageKey&) {
+    recency.pushBack(frameIndex);
+}
+
+void LruReplacementPolicy::onHit(int frameIndex) {
+    recency.moveToBack(frameIndex);
+}
+
+void LruReplacementPolicy::onRelease(int frameIndex) {
+    if (recency.contains(frameIndex)) recency.remove(frameIndex);
+}
+
+int LruReplacementPolicy::selectVictim(const PageKey&) {
+    return recency.popFront();
+}
+
+void ClockReplacementPolicy::onPageIn(int frameIndex, const PageKey&) {
+    if (!resident[frameIndex]) ++residentCount;
+    resident[frameIndex] = true;
+    referenced[frameIndex] = true;
+}
+
+void ClockReplacementPolicy::onHit(int frameIndex) {
+    referenced[frameIndex] = true;
+}
+
+void ClockReplacementPolicy::onRelease(int frameIndex) {
+    if (resident[frameIndex]) --residentCount;
+    resident[frameIndex] = false;
+    referenced[frameIndex] = false;
+}
+
+int ClockReplacementPolicy::selectVictim(const PageKey&) {
+    if (residentCount == 0) return -1;
+
+    // Every resident frame is seen at most twice: once to clear its bit, once to take it.
+    size_t frameCount = resident.size();
+    while (true) {
+        size_t frameIndex = hand;
+        hand = (hand + 1) % frameCount;
+        if (!resident[frameIndex]) continue;
+        if (referenced[frameIndex]) {
+            referenced[frameIndex] = false;
+            continue;
+        }
+        resident[frameIndex] = false;
+        --residentCount;
+        return static_cast<int>(frameIndex);
+    }
+}
+
+void LfuReplacementPolicy::onPageIn(int frameIndex, const PageKey&) {
+    useCount[frameIndex] = 1;
+    lastUse[frameIndex] = ++clock;
+    ranking.insert(rankOf(frameIndex));
+}
+
+void LfuReplacementPolicy::onHit(int frameIndex) {
+    ranking.erase(rankOf(frameIndex));
+    ++useCount[frameIndex];
+    lastUse[frameIndex] = ++clock;
+    ranking.insert(rankOf(frameIndex));
+}
+
+void LfuReplacementPolicy::onRelease(int frameIndex) {
+    ranking.erase(rankOf(frameIndex));
+}
+
+int LfuReplacementPolicy::selectVictim(const PageKey&) {
+    if (ranking.empty()) return -1;
+    int frameIndex = std::get<2>(*ranking.begin());
+    ranking.erase(ranking.begin());
+    return frameIndex;
+}
+
+void ArcReplacementPolicy::onPageIn(int frameIndex, const PageKey& page) {
+    frameKeys[frameIndex] = page;
+
+    size_t b1Size = b1.size();
+    size_t b2Size = b2.size();
+    if (b1.contains(page)) {
+        // A recent-only page came back: recency deserves more room.
+        target = std::min(capacity, target + std::max<size_t>(1, b2Size / b1Size));
+        b1.remove(page);
+        t2.pushBack(frameIndex);
+    } else if (b2.contains(page)) {
+        // A frequent page came back: frequency deserves more room.
+        target -= std::min(target, std::max<size_t>(1, b1Size / b2Size));
+        b2.remove(page);
+        t2.pushBack(frameIndex);
+    } else {
+        t1.pushBack(frameIndex);
+        while (t1.size() + b1.size() > capacity && b1.size() > 0) {
+            b1.popFront();
+        }
+    }
+    trimGhosts();
+}
+
+void ArcReplacementPolicy::onHit(int frameIndex) {
+    if (t1.contains(frameIndex)) {
+        t1.remove(frameIndex);
+        t2.pushBack(frameIndex);
+    } else if (t2.contains(frameIndex)) {
+        t2.moveToBack(frameIndex);
+    }
+}
+
+void ArcReplacementPolicy::onRelease(int frameIndex) {
+    if (t1.contains(frameIndex)) t1.remove(frameIndex);
+    else if (t2.contains(frameIndex)) t2.remove(frameIndex);
+}
+
+int ArcReplacementPolicy::selectVictim(const PageKey& incoming) {
+    bool incomingFrequent = b2.contains(incoming);
+    int frameIndex;
+    if (!t1.empty() && (t1.size() > target || (incomingFrequent && t1.size() == target) || t2.empty())) {
+        frameIndex = t1.popFront();
+        b1.pushBack(frameKeys[frameIndex]);
+    } else if (!t2.empty()) {
+        frameIndex = t2.popFront();
+        b2.pushBack(frameKeys[frameIndex]);
+    } else {
+        return -1;
+    }
+    trimGhosts();
+    return frameIndex;
+}
+
+void ArcReplacementPolicy::trimGhosts() {
+    // ARC remembers at most one cache's worth of evicted pages.
+    while (t1.size() + t2.size() + b1.size() + b2.size() > 2 * capacity) {
+        if (b2.size() > 0) b2.popFront();
+        else if (b1.size() > 0) b1.popFront();
+        else break;
+    }
+}
+
+void TwoQueueReplacementPolicy::onPageIn(int frameIndex, const PageKey& page) {
+    frameKeys[frameIndex] = page;
+    if (a1out.remove(page)) {
+        am.pushBack(frameIndex);
+    } else {
+        a1in.pushBack(frameIndex);
+    }
+}
+
+void TwoQueueReplacementPolicy::onHit(int frameIndex) {
+    // Hits in A1in are deliberately ignored so one burst of accesses cannot promote a page.
+    if (am.contains(frameIndex)) am.moveToBack(frameIndex);
+}
+
+void TwoQueueReplacementPolicy::onRelease(int frameIndex) {
+    if (a1in.contains(frameIndex)) a1in.remove(frameIndex);
+    else if (am.contains(frameIndex)) am.remove(frameIndex);
+}
+
+int TwoQueueReplacementPolicy::selectVictim(const PageKey&) {
+    if (!a1in.empty() && (a1in.size() > inLimit || am.empty())) {
+        int frameIndex = a1in.popFront();
+        a1out.pushBack(frameKeys[frameIndex]);
+        if (a1out.size() > outLimit) a1out.popFront();
+        return frameIndex;
+    }
+    return am.popFront();
+}
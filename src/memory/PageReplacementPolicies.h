@@ -0,0 +1,212 @@
+#pragma once
+
+#include "memory/IPageReplacementPolicy.h"
+
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+// Doubly linked list of frames threaded through per-frame prev/next arrays, so membership
+// changes are O(1) and nothing is allocated after construction.
+class FrameList {
+public:
+    explicit FrameList(size_t frameCount)
+        : prev(frameCount, -1), next(frameCount, -1), member(frameCount, false), head(-1), tail(-1), count(0) {}
+
+    void pushBack(int frameIndex) {
+        prev[frameIndex] = tail;
+        next[frameIndex] = -1;
+        if (tail >= 0) next[tail] = frameIndex; else head = frameIndex;
+        tail = frameIndex;
+        member[frameIndex] = true;
+        ++count;
+    }
+
+    void remove(int frameIndex) {
+        int p = prev[frameIndex];
+        int n = next[frameIndex];
+        if (p >= 0) next[p] = n; else head = n;
+        if (n >= 0) prev[n] = p; else tail = p;
+        prev[frameIndex] = -1;
+        next[frameIndex] = -1;
+        member[frameIndex] = false;
+        --count;
+    }
+
+    void moveToBack(int frameIndex) {
+        if (frameIndex == tail) return;
+        remove(frameIndex);
+        pushBack(frameIndex);
+    }
+
+    int popFront() {
+        int frameIndex = head;
+        if (frameIndex >= 0) remove(frameIndex);
+        return frameIndex;
+    }
+
+    bool contains(int frameIndex) const { return member[frameIndex]; }
+    int front() const { return head; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+private:
+    std::vector<int> prev;
+    std::vector<int> next;
+    std::vector<bool> member;
+    int head;
+    int tail;
+    size_t count;
+};
+
+// Recency-ordered set of recently evicted page identities (ARC's B1/B2, 2Q's A1out).
+class GhostList {
+public:
+    void pushBack(const PageKey& page) {
+        order.push_back(page);
+        index[page] = std::prev(order.end());
+    }
+
+    bool remove(const PageKey& page) {
+        auto found = index.find(page);
+        if (found == index.end()) return false;
+        order.erase(found->second);
+        index.erase(found);
+        return true;
+    }
+
+    void popFront() {
+        if (order.empty()) return;
+        index.erase(order.front());
+        order.pop_front();
+    }
+
+    bool contains(const PageKey& page) const { return index.count(page) > 0; }
+    size_t size() const { return order.size(); }
+
+private:
+    std::list<PageKey> order;
+    std::unordered_map<PageKey, std::list<PageKey>::iterator, PageKeyHash> index;
+};
+
+class FifoReplacementPolicy : public IPageReplacementPolicy {
+public:
+    explicit FifoReplacementPolicy(size_t frameCount) : queue(frameCount) {}
+
+    const char* getName() const override { return "FIFO"; }
+    void onPageIn(int frameIndex, const PageKey& page) override;
+    void onHit(int frameIndex) override;
+    bool tracksHits() const override { return false; }
+    void onRelease(int frameIndex) override;
+    int selectVictim(const PageKey& incoming) override;
+
+private:
+    FrameList queue;
+};
+
+class LruReplacementPolicy : public IPageReplacementPolicy {
+public:
+    explicit LruReplacementPolicy(size_t frameCount) : recency(frameCount) {}
+
+    const char* getName() const override { return "LRU"; }
+    void onPageIn(int frameIndex, const PageKey& page) override;
+    void onHit(int frameIndex) override;
+    void onRelease(int frameIndex) override;
+    int selectVictim(const PageKey& incoming) override;
+
+private:
+    FrameList recency;
+};
+
+// Second-chance over the frame array: the hand clears reference bits until it finds a cold frame.
+class ClockReplacementPolicy : public IPageReplacementPolicy {
+public:
+    explicit ClockReplacementPolicy(size_t frameCount)
+        : resident(frameCount, false), referenced(frameCount, false), hand(0), residentCount(0) {}
+
+    const char* getName() const override { return "CLOCK"; }
+    void onPageIn(int frameIndex, const PageKey& page) override;
+    void onHit(int frameIndex) override;
+    void onRelease(int frameIndex) override;
+    int selectVictim(const PageKey& incoming) override;
+
+private:
+    std::vector<bool> resident;
+    std::vector<bool> referenced;
+    size_t hand;
+    size_t residentCount;
+};
+
+// Least frequently used since page-in; ties go to the least recently used frame.
+class LfuReplacementPolicy : public IPageReplacementPolicy {
+public:
+    explicit LfuReplacementPolicy(size_t frameCount)
+        : useCount(frameCount, 0), lastUse(frameCount, 0), clock(0) {}
+
+    const char* getName() const override { return "LFU"; }
+    void onPageIn(int frameIndex, const PageKey& page) override;
+    void onHit(int frameIndex) override;
+    void onRelease(int frameIndex) override;
+    int selectVictim(const PageKey& incoming) override;
+
+private:
+    using Rank = std::tuple<long long, unsigned long long, int>;
+    Rank rankOf(int frameIndex) const { return { useCount[frameIndex], lastUse[frameIndex], frameIndex }; }
+
+    std::vector<long long> useCount;
+    std::vector<unsigned long long> lastUse;
+    unsigned long long clock;
+    std::set<Rank> ranking;
+};
+
+// Adaptive Replacement Cache (Megiddo and Modha): T1 holds pages seen once, T2 pages seen
+// again, and the ghost lists B1/B2 steer the T1 target size p towards whichever is missing more.
+class ArcReplacementPolicy : public IPageReplacementPolicy {
+public:
+    explicit ArcReplacementPolicy(size_t frameCount)
+        : capacity(frameCount), target(0), t1(frameCount), t2(frameCount), frameKeys(frameCount) {}
+
+    const char* getName() const override { return "ARC"; }
+    void onPageIn(int frameIndex, const PageKey& page) override;
+    void onHit(int frameIndex) override;
+    void onRelease(int frameIndex) override;
+    int selectVictim(const PageKey& incoming) override;
+
+private:
+    size_t capacity;
+    size_t target;
+    FrameList t1;
+    FrameList t2;
+    GhostList b1;
+    GhostList b2;
+    std::vector<PageKey> frameKeys;
+
+    void trimGhosts();
+};
+
+// Full 2Q (Johnson and Shasha): first-time pages wait in the FIFO A1in, and only pages that
+// fault again while remembered in the ghost list A1out are promoted into the LRU Am.
+class TwoQueueReplacementPolicy : public IPageReplacementPolicy {
+public:
+    explicit TwoQueueReplacementPolicy(size_t frameCount)
+        : inLimit(std::max<size_t>(1, frameCount / 4)), outLimit(std::max<size_t>(1, frameCount / 2)),
+          a1in(frameCount), am(frameCount), frameKeys(frameCount) {}
+
+    const char* getName() const override { return "2Q"; }
+    void onPageIn(int frameIndex, const PageKey& page) override;
+    void onHit(int frameIndex) override;
+    void onRelease(int frameIndex) override;
+    int selectVictim(const PageKey& incoming) override;
+
+private:
+    size_t inLimit;
+    size_t outLimit;
+    FrameList a1in;
+    FrameList am;
+    GhostList a1out;
+    std::vector<PageKey> frameKeys;
+};
@@ -0,0 +1,276 @@
+#include "memory/SegregatedFitAllocator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+
+SegregatedFitAllocator::SegregatedFitAllocator(size_t totalMemorySize, size_t frameSize)
+    : frameSize(std::max<size_t>(frameSize, 1)),
+      memory(totalMemorySize, 0),
+      sizeClasses(sizeClassOf(std::max<size_t>(totalMemorySize, 1)) + 1),
+      freeBytes(0),
+      liveAllocations(0),
+      compactions(0),
+      bytesCompacted(0),
+      totalCompactionNanos(0),
+      admissionsByCompaction(0) {
+    if (totalMemorySize > 0) {
+        insertFreeUnlocked(0, totalMemorySize);
+    }
+}
+
+int SegregatedFitAllocator::sizeClassOf(size_t size) {
+    int sizeClass = 0;
+    while (size >>= 1) ++sizeClass;
+    return sizeClass;
+}
+
+void* SegregatedFitAllocator::allocate(std::shared_ptr<Process> process) {
+    if (process->getMemoryHandle() >= 0) {
+        return reinterpret_cast<void*>(1);
+    }
+
+    uint32_t memoryRequired = process->getMemoryRequired();
+    size_t size = std::max<size_t>(memoryRequired, 1);
+
+    int handle;
+    size_t offset;
+    {
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        if (size > freeBytes) {
+            return nullptr;
+        }
+
+        offset = takeBestFitUnlocked(size);
+        if (offset == SIZE_MAX) {
+            // Enough is free, just not in one piece.
+            compactUnlocked();
+            offset = takeBestFitUnlocked(size);
+            if (offset == SIZE_MAX) {
+                return nullptr;
+            }
+            ++admissionsByCompaction;
+        }
+
+        if (!freeHandles.empty()) {
+            handle = freeHandles.back();
+            freeHandles.pop_back();
+        } else {
+            handle = static_cast<int>(allocations.size());
+            allocations.emplace_back();
+        }
+        allocations[handle] = Allocation{offset, size, true};
+        ++liveAllocations;
+        std::fill_n(memory.begin() + offset, size, 0);
+    }
+
+    process->setMemoryHandle(handle);
+    process->setMemory(memoryRequired, static_cast<uint32_t>((size + frameSize - 1) / frameSize));
+    return memory.data() + offset;
+}
+
+void SegregatedFitAllocator::deallocate(std::shared_ptr<Process> process) {
+    int handle = process->getMemoryHandle();
+    if (handle < 0) {
+        return;
+    }
+
+    {
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        if (static_cast<size_t>(handle) >= allocations.size() || !allocations[handle].inUse) {
+            return;
+        }
+
+        Allocation& allocation = allocations[handle];
+        size_t offset = allocation.offset;
+        size_t size = allocation.size;
+        allocation = Allocation{};
+        freeHandles.push_back(handle);
+        --liveAllocations;
+
+        // Merge with the free extents on either side.
+        auto next = freeByOffset.lower_bound(offset);
+        if (next != freeByOffset.end() && next->first == offset + size) {
+            size += next->second;
+            next = std::next(next);
+            eraseFreeUnlocked(std::prev(next));
+        }
+        if (next != freeByOffset.begin()) {
+            auto previous = std::prev(next);
+            if (previous->first + previous->second == offset) {
+                offset = previous->first;
+                size += previous->second;
+                eraseFreeUnlocked(previous);
+            }
+        }
+        insertFreeUnlocked(offset, size);
+    }
+
+    process->setMemoryHandle(-1);
+    uint32_t memoryRequired = process->getMemoryRequired();
+    process->setMemory(memoryRequired, 0);
+}
+
+size_t SegregatedFitAllocator::takeBestFitUnlocked(size_t size) {
+    // Within the request's own class the smallest fitting extent is searched for; any extent in a
+    // higher class fits, and its smallest is the best fit overall.
+    for (size_t sizeClass = sizeClassOf(size); sizeClass < sizeClasses.size(); ++sizeClass) {
+        auto fit = sizeClasses[sizeClass].lower_bound(Extent(size, 0));
+        if (fit == sizeClasses[sizeClass].end()) continue;
+
+        size_t offset = fit->second;
+        size_t extentSize = fit->first;
+        eraseFreeUnlocked(freeByOffset.find(offset));
+        if (extentSize > size) {
+            insertFreeUnlocked(offset + size, extentSize - size);
+        }
+        return offset;
+    }
+    return SIZE_MAX;
+}
+
+void SegregatedFitAllocator::insertFreeUnlocked(size_t offset, size_t size) {
+    freeByOffset.emplace(offset, size);
+    sizeClasses[sizeClassOf(size)].insert(Extent(size, offset));
+    freeBytes += size;
+}
+
+void SegregatedFitAllocator::eraseFreeUnlocked(std::map<size_t, size_t>::iterator extent) {
+    sizeClasses[sizeClassOf(extent->second)].erase(Extent(extent->second, extent->first));
+    freeBytes -= extent->second;
+    freeByOffset.erase(extent);
+}
+
+void SegregatedFitAllocator::compactUnlocked() {
+    auto started = std::chrono::steady_clock::now();
+
+    std::vector<int> byOffset;
+    byOffset.reserve(liveAllocations);
+    for (size_t handle = 0; handle < allocations.size(); ++handle) {
+        if (allocations[handle].inUse) byOffset.push_back(static_cast<int>(handle));
+    }
+    std::sort(byOffset.begin(), byOffset.end(), [this](int a, int b) {
+        return allocations[a].offset < allocations[b].offset;
+    });
+
+    // Sliding in address order never overwrites an allocation that has yet to move.
+    size_t top = 0;
+    for (int handle : byOffset) {
+        Allocation& allocation = allocations[handle];
+        if (allocation.offset != top) {
+            std::memmove(memory.data() + top, memory.data() + allocation.offset, allocation.size);
+            bytesCompacted += static_cast<long long>(allocation.size);
+            allocation.offset = top;
+        }
+        top += allocation.size;
+    }
+
+    freeByOffset.clear();
+    for (auto& sizeClass : sizeClasses) sizeClass.clear();
+    freeBytes = 0;
+    if (top < memory.size()) {
+        insertFreeUnlocked(top, memory.size() - top);
+    }
+
+    ++compactions;
+    totalCompactionNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - started).count();
+}
+
+size_t SegregatedFitAllocator::locateUnlocked(const Process& process, uint32_t address) const {
+    int handle = process.getMemoryHandle();
+    if (handle < 0 || static_cast<size_t>(handle) >= allocations.size()) return SIZE_MAX;
+    const Allocation& allocation = allocations[handle];
+    if (!allocation.inUse || static_cast<uint64_t>(address) + 2 > allocation.size) return SIZE_MAX;
+    return allocation.offset + address;
+}
+
+MemoryAccessResult SegregatedFitAllocator::readWord(Process& process, int, uint32_t address, uint16_t& value) {
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    size_t base = locateUnlocked(process, address);
+    if (base == SIZE_MAX) return MemoryAccessResult::OUT_OF_RANGE;
+    value = static_cast<uint16_t>(memory[base] | (memory[base + 1] << 8));
+    return MemoryAccessResult::OK;
+}
+
+MemoryAccessResult SegregatedFitAllocator::writeWord(Process& process, int, uint32_t address, uint16_t value) {
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    size_t base = locateUnlocked(process, address);
+    if (base == SIZE_MAX) return MemoryAccessResult::OUT_OF_RANGE;
+    memory[base] = static_cast<uint8_t>(value & 0xFF);
+    memory[base + 1] = static_cast<uint8_t>(value >> 8);
+    return MemoryAccessResult::OK;
+}
+
+void SegregatedFitAllocator::visualizeMemory() const {
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    std::cout << "Memory Visualization:\n";
+    std::cout << "Free Extents: ";
+    for (const auto& extent : freeByOffset) {
+        std::cout << "[" << extent.first << ", " << extent.first + extent.second << ") ";
+    }
+    std::cout << std::endl;
+
+    std::cout << "Allocations: \n";
+    for (size_t handle = 0; handle < allocations.size(); ++handle) {
+        const Allocation& allocation = allocations[handle];
+        if (!allocation.inUse) continue;
+        std::cout << "Handle " << handle << " at [" << allocation.offset << ", "
+                  << allocation.offset + allocation.size << ")" << std::endl;
+    }
+}
+
+size_t SegregatedFitAllocator::getAllocationCount() const {
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    return liveAllocations;
+}
+
+size_t SegregatedFitAllocator::getFreeExtentCount() const {
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    return freeByOffset.size();
+}
+
+size_t SegregatedFitAllocator::getFreeBytes() const {
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    return freeBytes;
+}
+
+size_t SegregatedFitAllocator::getLargestFreeExtent() const {
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    return largestFreeUnlocked();
+}
+
+double SegregatedFitAllocator::getExternalFragmentation() const {
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    if (freeBytes == 0) return 0.0;
+    return 1.0 - static_cast<double>(largestFreeUnlocked()) / freeBytes;
+}
+
+long long SegregatedFitAllocator::getCompactions() const {
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    return compactions;
+}
+
+long long SegregatedFitAllocator::getBytesCompacted() const {
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    return bytesCompacted;
+}
+
+long long SegregatedFitAllocator::getTotalCompactionNanos() const {
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    return totalCompactionNanos;
+}
+
+long long SegregatedFitAllocator::getAdmissionsByCompaction() const {
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    return admissionsByCompaction;
+}
+
+size_t SegregatedFitAllocator::largestFreeUnlocked() const {
+    for (auto sizeClass = sizeClasses.rbegin(); sizeClass != sizeClasses.rend(); ++sizeClass) {
+        if (!sizeClass->empty()) return sizeClass->rbegin()->first;
+    }
+    return 0;
+}
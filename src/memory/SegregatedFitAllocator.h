@@ -0,0 +1,74 @@
+#pragma once
+
+#include "memory/IMemoryAllocator.h"
+#include "core/Process.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+// Contiguous allocator with segregated free lists: free extents are binned by power-of-two size
+// class and the best fit is taken from the first class that can hold the request. When no extent
+// fits but enough memory is free in total, a compaction pass slides every live allocation down to
+// the start of memory, leaving one free extent at the end.
+class SegregatedFitAllocator : public IMemoryAllocator {
+public:
+    // frameSize only sets the unit in which a process's allocation is reported as pages.
+    SegregatedFitAllocator(size_t totalMemorySize, size_t frameSize);
+
+    void* allocate(std::shared_ptr<Process> process) override;
+    void deallocate(std::shared_ptr<Process> process) override;
+    void visualizeMemory() const override;
+    MemoryAccessResult readWord(Process& process, int coreId, uint32_t address, uint16_t& value) override;
+    MemoryAccessResult writeWord(Process& process, int coreId, uint32_t address, uint16_t value) override;
+
+    size_t getAllocationCount() const;
+    size_t getFreeExtentCount() const;
+    size_t getFreeBytes() const;
+    size_t getLargestFreeExtent() const;
+    // 1 - largest free extent / free bytes.
+    double getExternalFragmentation() const;
+    long long getCompactions() const;
+    long long getBytesCompacted() const;
+    long long getTotalCompactionNanos() const;
+    // Allocations that only succeeded because a compaction made room.
+    long long getAdmissionsByCompaction() const;
+
+private:
+    struct Allocation {
+        size_t offset = 0;
+        size_t size = 0;
+        bool inUse = false;
+    };
+    using Extent = std::pair<size_t, size_t>;   // (size, offset), so a class's set is ordered best fit first
+
+    size_t frameSize;
+    std::vector<uint8_t> memory;
+
+    // Workers read and write under a shared lock; allocation, release and compaction take it exclusively.
+    mutable std::shared_mutex mtx;
+    std::map<size_t, size_t> freeByOffset;      // offset -> size, for coalescing with neighbours
+    std::vector<std::set<Extent>> sizeClasses;  // class k holds extents of [2^k, 2^(k+1)) bytes
+    // Indexed by the process's memory handle, which survives compaction unlike the offset.
+    std::vector<Allocation> allocations;
+    std::vector<int> freeHandles;
+    size_t freeBytes;
+    size_t liveAllocations;
+
+    long long compactions;
+    long long bytesCompacted;
+    long long totalCompactionNanos;
+    long long admissionsByCompaction;
+
+    static int sizeClassOf(size_t size);
+    size_t takeBestFitUnlocked(size_t size);    // returns SIZE_MAX when no extent fits
+    void insertFreeUnlocked(size_t offset, size_t size);
+    void eraseFreeUnlocked(std::map<size_t, size_t>::iterator extent);
+    void compactUnlocked();
+    size_t locateUnlocked(const Process& process, uint32_t address) const;
+    size_t largestFreeUnlocked() const;
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Set-associative cache of (process handle, page) -> frame translations for one simulated core.
+// The core holds mtx while it looks up and uses a cached frame; shootdowns from other threads
+// take the same lock, so once one returns no access through the old translation is in flight.
+class TranslationBuffer {
+public:
+    TranslationBuffer(size_t entryCount, size_t ways)
+        : ways(ways), setCount(entryCount / ways), entries(entryCount), useClock(0),
+          hits(0), misses(0), shootdowns(0) {}
+
+    TranslationBuffer(const TranslationBuffer&) = delete;
+    TranslationBuffer& operator=(const TranslationBuffer&) = delete;
+
+    std::mutex mtx;
+
+    // Returns the cached frame, or -1. Caller holds mtx.
+    int lookupUnlocked(int handle, int pageNumber) {
+        Entry* set = setOf(handle, pageNumber);
+        for (size_t w = 0; w < ways; ++w) {
+            if (set[w].handle == handle && set[w].pageNumber == pageNumber) {
+                set[w].lastUse = ++useClock;
+                return set[w].frameIndex;
+            }
+        }
+        return -1;
+    }
+
+    // Caches a translation, replacing an empty way or else the least recently used one. Caller holds mtx.
+    void insertUnlocked(int handle, int pageNumber, int frameIndex) {
+        Entry* set = setOf(handle, pageNumber);
+        Entry* slot = &set[0];
+        for (size_t w = 0; w < ways; ++w) {
+            Entry& entry = set[w];
+            if (entry.handle < 0 || (entry.handle == handle && entry.pageNumber == pageNumber)) {
+                slot = &entry;
+                break;
+            }
+            if (entry.lastUse < slot->lastUse) slot = &entry;
+        }
+        *slot = Entry{handle, pageNumber, frameIndex, ++useClock};
+    }
+
+    // The page is being evicted.
+    void invalidatePage(int handle, int pageNumber) {
+        std::lock_guard<std::mutex> lock(mtx);
+        Entry* set = setOf(handle, pageNumber);
+        for (size_t w = 0; w < ways; ++w) {
+            if (set[w].handle == handle && set[w].pageNumber == pageNumber) {
+                set[w] = Entry{};
+                shootdowns.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // The process is being deallocated and its handle may be reused.
+    void invalidateProcess(int handle) {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (Entry& entry : entries) {
+            if (entry.handle == handle) {
+                entry = Entry{};
+                shootdowns.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void recordLookup(bool hit) {
+        (hit ? hits : misses).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    long long getHits() const { return hits.load(std::memory_order_relaxed); }
+    long long getMisses() const { return misses.load(std::memory_order_relaxed); }
+    long long getShootdowns() const { return shootdowns.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry {
+        int handle = -1;
+        int pageNumber = -1;
+        int frameIndex = -1;
+        uint64_t lastUse = 0;
+    };
+
+    // Consecutive pages of one process land in consecutive sets.
+    Entry* setOf(int handle, int pageNumber) {
+        size_t key = static_cast<uint32_t>(pageNumber) + static_cast<size_t>(static_cast<uint32_t>(handle)) * 0x9E3779B1u;
+        return &entries[(key % setCount) * ways];
+    }
+
+    size_t ways;
+    size_t setCount;
+    std::vector<Entry> entries;
+    uint64_t useClock;
+
+    std::atomic<long long> hits;
+    std::atomic<long long> misses;
+    std::atomic<long long> shootdowns;
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Sliding window over a process's last `window` page references: the working set is the number of
+// distinct pages in it, the fault frequency the share of those references that faulted.
+// Only the core running the process records; the sizes are published for the scheduler to read.
+class WorkingSetEstimator {
+public:
+    WorkingSetEstimator() : next(0), filled(0), faultsInWindow(0), size(0), faults(0), windowSize(0) {}
+
+    WorkingSetEstimator(const WorkingSetEstimator&) = delete;
+    WorkingSetEstimator& operator=(const WorkingSetEstimator&) = delete;
+
+    // While the process holds no memory; window 0 turns recording off.
+    void reset(size_t window, size_t pageCount) {
+        recent.assign(window, Reference{});
+        counts.assign(window > 0 ? pageCount : 0, 0);
+        next = 0;
+        filled = 0;
+        faultsInWindow = 0;
+        size.store(0, std::memory_order_relaxed);
+        faults.store(0, std::memory_order_relaxed);
+        windowSize.store(static_cast<uint32_t>(window), std::memory_order_relaxed);
+    }
+
+    void record(int pageNumber, bool faulted) {
+        if (recent.empty() || pageNumber < 0 || static_cast<size_t>(pageNumber) >= counts.size()) return;
+
+        uint32_t distinct = size.load(std::memory_order_relaxed);
+        Reference& slot = recent[next];
+        if (filled == recent.size()) {
+            if (--counts[slot.pageNumber] == 0) --distinct;
+            if (slot.faulted) --faultsInWindow;
+        } else {
+            ++filled;
+        }
+        slot = Reference{pageNumber, faulted};
+        if (counts[pageNumber]++ == 0) ++distinct;
+        if (faulted) ++faultsInWindow;
+        next = (next + 1) % recent.size();
+
+        size.store(distinct, std::memory_order_relaxed);
+        faults.store(faultsInWindow, std::memory_order_relaxed);
+    }
+
+    size_t getSize() const { return size.load(std::memory_order_relaxed); }
+    // Faults per reference over the window.
+    double getFaultFrequency() const {
+        uint32_t window = windowSize.load(std::memory_order_relaxed);
+        return window > 0 ? static_cast<double>(faults.load(std::memory_order_relaxed)) / window : 0.0;
+    }
+
+private:
+    struct Reference {
+        int pageNumber = 0;
+        bool faulted = false;
+    };
+
+    std::vector<Reference> recent;      // ring buffer, oldest at next once full
+    std::vector<uint32_t> counts;       // references to each page within the window
+    size_t next;
+    size_t filled;
+    uint32_t faultsInWindow;
+
+    std::atomic<uint32_t> size;
+    std::atomic<uint32_t> faults;
+    std::atomic<uint32_t> windowSize;
+};
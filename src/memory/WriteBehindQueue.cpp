@@ -0,0 +1,96 @@
+#include "memory/WriteBehindQueue.h"
+#include "memory/BackingStore.h"
+
+#include <algorithm>
+
+WriteBehindQueue::WriteBehindQueue(size_t capacity)
+    : capacity(std::max<size_t>(capacity, 1)),
+      stalls(0),
+      stopping(false),
+      writer(&WriteBehindQueue::writerLoop, this) {
+}
+
+WriteBehindQueue::~WriteBehindQueue() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+        queue.clear();
+        newest.clear();
+    }
+    hasWork.notify_all();
+    hasRoom.notify_all();
+    if (writer.joinable()) {
+        writer.join();
+    }
+}
+
+void WriteBehindQueue::enqueue(const std::string& processName, int pageNumber, std::vector<uint8_t> pageData) {
+    auto pending = std::make_shared<PendingWrite>(PendingWrite{processName, pageNumber, std::move(pageData)});
+
+    std::unique_lock<std::mutex> lock(mtx);
+    if (queue.size() >= capacity) {
+        ++stalls;
+        hasRoom.wait(lock, [&] { return queue.size() < capacity || stopping; });
+    }
+    if (stopping) return;
+
+    newest[PageId(processName, pageNumber)] = pending;
+    queue.push_back(std::move(pending));
+    hasWork.notify_one();
+}
+
+bool WriteBehindQueue::readPending(const std::string& processName, int pageNumber, std::vector<uint8_t>& pageData) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto found = newest.find(PageId(processName, pageNumber));
+    if (found == newest.end()) return false;
+    pageData = found->second->pageData;
+    return true;
+}
+
+void WriteBehindQueue::cancel(const std::string& processName) {
+    std::unique_lock<std::mutex> lock(mtx);
+    // Queued entries left behind no longer match newest and are skipped by the writer.
+    auto first = newest.lower_bound(PageId(processName, 0));
+    auto last = first;
+    while (last != newest.end() && last->first.first == processName) ++last;
+    newest.erase(first, last);
+
+    writeDone.wait(lock, [&] { return !writing || writing->processName != processName; });
+}
+
+size_t WriteBehindQueue::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return newest.size();
+}
+
+long long WriteBehindQueue::getStallCount() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return stalls;
+}
+
+void WriteBehindQueue::writerLoop() {
+    std::unique_lock<std::mutex> lock(mtx);
+    while (true) {
+        hasWork.wait(lock, [&] { return stopping || !queue.empty(); });
+        if (stopping) break;
+
+        std::shared_ptr<PendingWrite> pending = std::move(queue.front());
+        queue.pop_front();
+        hasRoom.notify_one();
+
+        PageId id(pending->processName, pending->pageNumber);
+        auto found = newest.find(id);
+        if (found == newest.end() || found->second != pending) continue;
+
+        writing = pending;
+        lock.unlock();
+        BackingStore::pageOut(pending->processName, pending->pageNumber, pending->pageData);
+        lock.lock();
+        writing.reset();
+
+        // Only now may a fault read the page from the store instead of from here.
+        found = newest.find(id);
+        if (found != newest.end() && found->second == pending) newest.erase(found);
+        writeDone.notify_all();
+    }
+}
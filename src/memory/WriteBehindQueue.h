@@ -0,0 +1,58 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Bounded queue of evicted dirty pages, written to the BackingStore by one background thread.
+// Until its write completes, the newest copy of a page stays readable here, so a fault on it
+// never waits for the file; only an evictor facing a full queue blocks.
+class WriteBehindQueue {
+public:
+    explicit WriteBehindQueue(size_t capacity);
+    // Stops the writer; page-outs still queued are dropped along with the session.
+    ~WriteBehindQueue();
+
+    WriteBehindQueue(const WriteBehindQueue&) = delete;
+    WriteBehindQueue& operator=(const WriteBehindQueue&) = delete;
+
+    // Takes ownership of the page image; blocks while the queue is full.
+    void enqueue(const std::string& processName, int pageNumber, std::vector<uint8_t> pageData);
+    // Copies out the newest queued image of the page, if one has not reached the store yet.
+    bool readPending(const std::string& processName, int pageNumber, std::vector<uint8_t>& pageData);
+    // Drops the process's queued writes and waits out one already in progress.
+    void cancel(const std::string& processName);
+
+    size_t getPendingCount() const;
+    long long getStallCount() const;
+
+private:
+    struct PendingWrite {
+        std::string processName;
+        int pageNumber;
+        std::vector<uint8_t> pageData;
+    };
+    using PageId = std::pair<std::string, int>;
+
+    size_t capacity;
+    mutable std::mutex mtx;
+    std::condition_variable hasWork;
+    std::condition_variable hasRoom;
+    std::condition_variable writeDone;
+    std::deque<std::shared_ptr<PendingWrite>> queue;
+    // The newest image of each page not yet on disk; queued writes it does not point at are stale.
+    std::map<PageId, std::shared_ptr<PendingWrite>> newest;
+    std::shared_ptr<PendingWrite> writing;
+    long long stalls;
+    bool stopping;
+    std::thread writer;
+
+    void writerLoop();
+};